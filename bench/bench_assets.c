@@ -0,0 +1,19 @@
+#include "bench_framework.h"
+#include <engine/types.h>
+
+// Decode PNG and convert it to ARGB, optionally resampling to 'scale'
+static void bench_load_sprite_file(Bench *b, const char *path, float scale) {
+  Sprite probe = load_sprite(path, scale);
+  BENCH_REQUIRE(b, probe.pixels, "Failed to load sprite");
+  bench_set_items(b, (uint64_t)probe.width * probe.height, "pixel");
+  free_sprite(&probe);
+
+  BENCH_LOOP(b) {
+    Sprite sprite = load_sprite(path, scale);
+    bench_consume(sprite.pixels[0]);
+    free_sprite(&sprite);
+  }
+}
+
+REGISTER_BENCH(load_sprite) { bench_load_sprite_file(b, "demo/assets/tree.png", 1.0f); }
+REGISTER_BENCH(load_sprite_scaled) { bench_load_sprite_file(b, "demo/assets/grass_high.png", 1.0f / 7.2f); }
@@ -0,0 +1,177 @@
+#include "bench_framework.h"
+#include <SDL2/SDL.h>
+
+#define MAX_BENCHES 128
+#define DEFAULT_WARMUP 10
+#define DEFAULT_REPETITIONS 100
+
+typedef struct {
+  const char *name;
+  BenchFunc func;
+} BenchEntry;
+
+// Statistics of timed iterations, ns per iteration
+typedef struct {
+  uint64_t min, median, p90, p99, max;
+  double mean;
+} BenchStats;
+
+static BenchEntry benches[MAX_BENCHES];
+static int bench_count = 0;
+static volatile uint64_t bench_sink;
+
+void register_bench(const char *name, BenchFunc func) {
+  if (bench_count >= MAX_BENCHES) return;
+  benches[bench_count].name = name;
+  benches[bench_count].func = func;
+  bench_count++;
+}
+
+void bench_set_items(Bench *b, uint64_t items, const char *unit) {
+  b->items = items;
+  b->unit = unit;
+}
+
+static uint64_t now_ticks(void) { return SDL_GetPerformanceCounter(); }
+
+static uint64_t ticks_to_ns(uint64_t ticks) {
+  return (uint64_t)((double)ticks * 1e9 / (double)SDL_GetPerformanceFrequency());
+}
+
+void bench_limit_repetitions(Bench *b, uint32_t warmup, uint32_t repetitions) {
+  if (warmup < b->warmup) b->warmup = warmup;
+  if (repetitions > 0 && repetitions < b->repetitions) b->repetitions = repetitions;
+}
+
+void bench_begin(Bench *b) { b->iteration = 0; }
+
+bool bench_next(Bench *b) {
+  uint64_t now = now_ticks();
+  // Iteration that just finished, timed ones go after the warmup
+  if (b->iteration > b->warmup) b->samples[b->iteration - b->warmup - 1] = ticks_to_ns(now - b->start);
+  if (b->failed || b->iteration == b->warmup + b->repetitions) return false;
+  b->iteration++;
+  b->start = now_ticks();
+  return true;
+}
+
+void bench_consume(uint64_t value) { bench_sink += value; }
+
+static int compare_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted samples
+static uint64_t percentile(const uint64_t *sorted, uint32_t count, uint32_t pct) {
+  uint32_t rank = (count * pct + 99) / 100;
+  return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static BenchStats bench_stats(Bench *b) {
+  uint32_t n = b->repetitions;
+  qsort(b->samples, n, sizeof(uint64_t), compare_u64);
+  BenchStats s = {0};
+  double sum = 0.0;
+  for (uint32_t i = 0; i < n; i++) sum += (double)b->samples[i];
+  s.min = b->samples[0];
+  s.max = b->samples[n - 1];
+  s.median = percentile(b->samples, n, 50);
+  s.p90 = percentile(b->samples, n, 90);
+  s.p99 = percentile(b->samples, n, 99);
+  s.mean = sum / n;
+  return s;
+}
+
+static void write_json_entry(FILE *out, const Bench *b, const BenchStats *s, bool last) {
+  fprintf(out, "    {\n      \"name\": \"%s\",\n", b->name);
+  fprintf(out, "      \"repetitions\": %u,\n", b->repetitions);
+  if (b->failed) {
+    fprintf(out, "      \"failed\": true\n    }%s\n", last ? "" : ",");
+    return;
+  }
+  fprintf(out, "      \"min_ns\": %llu,\n", (unsigned long long)s->min);
+  fprintf(out, "      \"median_ns\": %llu,\n", (unsigned long long)s->median);
+  fprintf(out, "      \"mean_ns\": %.1f,\n", s->mean);
+  fprintf(out, "      \"p90_ns\": %llu,\n", (unsigned long long)s->p90);
+  fprintf(out, "      \"p99_ns\": %llu,\n", (unsigned long long)s->p99);
+  fprintf(out, "      \"max_ns\": %llu", (unsigned long long)s->max);
+  if (b->items > 0) {
+    fprintf(out, ",\n      \"unit\": \"%s\",\n", b->unit);
+    fprintf(out, "      \"items\": %llu,\n", (unsigned long long)b->items);
+    fprintf(out, "      \"median_ns_per_%s\": %.4f,\n", b->unit, (double)s->median / b->items);
+    fprintf(out, "      \"p99_ns_per_%s\": %.4f", b->unit, (double)s->p99 / b->items);
+  }
+  fprintf(out, "\n    }%s\n", last ? "" : ",");
+}
+
+static bool matches_filter(const char *name, int filter_count, char **filters) {
+  if (filter_count == 0) return true;
+  for (int i = 0; i < filter_count; i++) {
+    if (strstr(name, filters[i])) return true;
+  }
+  return false;
+}
+
+int bench_runner_main(int argc, char **argv) {
+  uint32_t warmup = DEFAULT_WARMUP, repetitions = DEFAULT_REPETITIONS;
+  const char *out_path = NULL;
+  char **filters = malloc(argc * sizeof(char *));
+  int filter_count = 0;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+      warmup = (uint32_t)atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+      repetitions = (uint32_t)atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      out_path = argv[++i];
+    } else {
+      filters[filter_count++] = argv[i];
+    }
+  }
+  if (repetitions == 0) repetitions = 1;
+
+  FILE *out = out_path ? fopen(out_path, "w") : stdout;
+  uint64_t *samples = malloc(repetitions * sizeof(uint64_t));
+  if (!out || !samples) {
+    fprintf(stderr, "Failed to open %s\n", out_path ? out_path : "stdout");
+    free(filters);
+    free(samples);
+    return 1;
+  }
+
+  int selected = 0, failed = 0;
+  for (int i = 0; i < bench_count; i++) selected += matches_filter(benches[i].name, filter_count, filters);
+
+  fprintf(out, "{\n  \"warmup\": %u,\n  \"repetitions\": %u,\n  \"benchmarks\": [\n", warmup, repetitions);
+  fprintf(stderr, "%-32s %12s %12s %14s\n", "benchmark", "median, us", "p99, us", "median ns/unit");
+  for (int i = 0, done = 0; i < bench_count; i++) {
+    if (!matches_filter(benches[i].name, filter_count, filters)) continue;
+    Bench b = {0};
+    b.name = benches[i].name;
+    b.warmup = warmup;
+    b.repetitions = repetitions;
+    b.samples = samples;
+    benches[i].func(&b);
+    // Benchmark that returned before its loop has no samples
+    if (!b.failed && b.iteration != b.warmup + b.repetitions) b.failed = true;
+
+    BenchStats s = {0};
+    if (b.failed) {
+      failed++;
+      fprintf(stderr, "%-32s %12s\n", b.name, "FAILED");
+    } else {
+      s = bench_stats(&b);
+      fprintf(stderr, "%-32s %12.1f %12.1f", b.name, s.median / 1e3, s.p99 / 1e3);
+      if (b.items > 0) fprintf(stderr, " %8.3f/%s", (double)s.median / b.items, b.unit);
+      fprintf(stderr, "\n");
+    }
+    write_json_entry(out, &b, &s, ++done == selected);
+  }
+  fprintf(out, "  ]\n}\n");
+
+  if (out != stdout) fclose(out);
+  free(samples);
+  free(filters);
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,60 @@
+#ifndef BENCH_FRAMEWORK_H
+#define BENCH_FRAMEWORK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// State of a running benchmark. Setup code runs before BENCH_LOOP and cleanup after it,
+// only the loop body is timed: 'warmup' untimed iterations, then 'repetitions' timed ones.
+typedef struct {
+  const char *name;
+  uint32_t warmup;
+  uint32_t repetitions;
+  uint64_t *samples; // duration of every timed iteration, ns
+  uint32_t iteration;
+  uint64_t start;
+  uint64_t items;   // units of work done by one iteration, e.g. pixels blended
+  const char *unit; // name of the unit, e.g. "pixel" or "object"
+  bool failed;
+} Bench;
+
+typedef void (*BenchFunc)(Bench *b);
+
+#define REGISTER_BENCH(name) \
+  void bench_##name(Bench *b); \
+  static void __attribute__((constructor)) __register_bench_##name(void) { \
+    register_bench(#name, bench_##name); \
+  } \
+  void bench_##name(Bench *b)
+
+// Timed loop: for (each warmup and timed iteration) { body }
+#define BENCH_LOOP(b) for (bench_begin(b); bench_next(b);)
+
+// Mark benchmark as failed (e.g. asset not found) and skip its loop.
+#define BENCH_REQUIRE(b, condition, message) \
+  do { \
+    if (!(condition)) { \
+      fprintf(stderr, "FAIL: %s:%d: %s\n", __FILE__, __LINE__, message); \
+      (b)->failed = true; \
+      return; \
+    } \
+  } while (0)
+
+void register_bench(const char *name, BenchFunc func);
+// Work done by one iteration, reported as ns per unit next to time per iteration.
+void bench_set_items(Bench *b, uint64_t items, const char *unit);
+// Lower warmup and repetitions for slow benchmarks (e.g. whole frames of huge scenes). Call before the loop.
+void bench_limit_repetitions(Bench *b, uint32_t warmup, uint32_t repetitions);
+void bench_begin(Bench *b);
+bool bench_next(Bench *b);
+// Keep the compiler from dropping computations whose results are otherwise unused.
+void bench_consume(uint64_t value);
+
+// Run benchmarks: bench_runner [-w warmup] [-r repetitions] [-o results.json] [name-filter...]
+// Summary goes to stderr, JSON results to the output file or stdout.
+int bench_runner_main(int argc, char **argv);
+
+#endif
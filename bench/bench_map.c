@@ -0,0 +1,76 @@
+#include "bench_framework.h"
+#include "graphics/camera.h"
+#include "graphics/render.h"
+#include "world/map_priv.h"
+#include <engine/map.h>
+#include <engine/random.h>
+
+#define FB_W 800
+#define FB_H 600
+#define MAP_SIZE 25 // tiles, same as the demo
+#define MAP_POINTS 4096
+
+// Map of the demo: grass tiles with sides
+static Map *bench_map(void) {
+  TilesInfo ti = {0};
+  ti.tile_sprites = calloc(1, sizeof(Sprite));
+  if (!ti.tile_sprites) return NULL;
+  ti.tile_sprites[0] = load_sprite("demo/assets/grass_high.png", 1.0f / 7.2f);
+  ti.sprite_count = 1;
+  ti.tiles = calloc(MAP_SIZE * MAP_SIZE, sizeof(uint32_t));
+  ti.sides_height = 64;
+  return map_create(MAP_SIZE, MAP_SIZE, ti);
+}
+
+// Full-screen view of the map center at 'zoom'
+static void bench_load_prerendered_zoom(Bench *b, float zoom) {
+  uint32_t *fb = calloc(FB_W * FB_H, sizeof(uint32_t));
+  Camera *camera = camera_create(FB_W, FB_H);
+  Map *map = bench_map();
+  BENCH_REQUIRE(b, fb && camera && map, "Failed to create map");
+  camera->target = (Vector){map->width_pix / 2.0f, map->height_pix / 2.0f};
+  camera_set_zoom(camera, zoom);
+  camera_snap(camera);
+
+  bench_set_items(b, FB_W * FB_H, "pixel");
+  BENCH_LOOP(b) { load_prerendered(fb, map, camera); }
+  map_free(map);
+  camera_free(camera);
+  free(fb);
+}
+
+REGISTER_BENCH(load_prerendered_zoom_1) { bench_load_prerendered_zoom(b, 1.0f); }
+REGISTER_BENCH(load_prerendered_zoom_2) { bench_load_prerendered_zoom(b, 2.0f); }
+REGISTER_BENCH(load_prerendered_zoom_0_25) { bench_load_prerendered_zoom(b, 0.25f); }
+
+// Redrawing tiles over the rendered map blends the same pixels as the first pass in map_create
+REGISTER_BENCH(map_render_tiles) {
+  Map *map = bench_map();
+  BENCH_REQUIRE(b, map, "Failed to create map");
+  const Sprite *tile = &map->ti.tile_sprites[0];
+
+  bench_set_items(b, (uint64_t)MAP_SIZE * MAP_SIZE * tile->width * tile->height, "pixel");
+  BENCH_LOOP(b) { map_render_tiles(map); }
+  map_free(map);
+}
+
+REGISTER_BENCH(is_point_within_map) {
+  Map *map = bench_map();
+  Vector *points = malloc(MAP_POINTS * sizeof(Vector));
+  BENCH_REQUIRE(b, map && points, "Failed to create map");
+  Rng rng;
+  rng_seed(&rng, 48);
+  // Points over the bounding rectangle: about half of them are outside of the map diamond
+  for (int i = 0; i < MAP_POINTS; i++) {
+    points[i] = (Vector){rng_float01(&rng) * map->width_pix, rng_float01(&rng) * map->height_pix};
+  }
+
+  bench_set_items(b, MAP_POINTS, "point");
+  uint64_t inside = 0;
+  BENCH_LOOP(b) {
+    for (int i = 0; i < MAP_POINTS; i++) inside += is_point_within_map(map, points[i], 16);
+  }
+  bench_consume(inside);
+  free(points);
+  map_free(map);
+}
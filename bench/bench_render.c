@@ -0,0 +1,171 @@
+#include "bench_framework.h"
+#include "graphics/alpha_blend.h"
+#include "graphics/camera.h"
+#include "graphics/render.h"
+#include "graphics/render_list_priv.h"
+#include "graphics/scale.h"
+#include <engine/alloc.h>
+#include <engine/random.h>
+#include <engine/render_list.h>
+#include <engine/types.h>
+
+#define FB_W 800
+#define FB_H 600
+#define BLEND_PIXELS (1 << 16)
+#define SPRITE_DRAWS 32
+#define SORT_OBJECTS 10000
+#define SORT_DYNAMIC 1000
+
+// Colors with alpha distribution of typical sprites: mostly opaque or transparent, edges translucent
+static void fill_colors(uint32_t *colors, uint32_t count, bool translucent_only) {
+  Rng rng;
+  rng_seed(&rng, 48);
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t rgb = rng_next(&rng) & 0x00FFFFFF;
+    uint32_t a = 1 + rng_range(&rng, 254);
+    if (!translucent_only) {
+      uint32_t kind = rng_range(&rng, 4);
+      if (kind == 0) a = 0;
+      if (kind == 1 || kind == 2) a = 255;
+    }
+    colors[i] = (a << 24) | rgb;
+  }
+}
+
+static void bench_alpha_blend_colors(Bench *b, bool translucent_only) {
+  uint32_t *top = malloc(BLEND_PIXELS * sizeof(uint32_t));
+  uint32_t *bot = malloc(BLEND_PIXELS * sizeof(uint32_t));
+  BENCH_REQUIRE(b, top && bot, "Out of memory");
+  fill_colors(top, BLEND_PIXELS, translucent_only);
+  for (uint32_t i = 0; i < BLEND_PIXELS; i++) bot[i] = 0xFF000000 | (i * 2654435761u);
+
+  bench_set_items(b, BLEND_PIXELS, "pixel");
+  BENCH_LOOP(b) {
+    for (uint32_t i = 0; i < BLEND_PIXELS; i++) bot[i] = alpha_blend(top[i], bot[i]);
+  }
+  bench_consume(bot[BLEND_PIXELS / 2]);
+  free(top);
+  free(bot);
+}
+
+REGISTER_BENCH(alpha_blend_mixed) { bench_alpha_blend_colors(b, false); }
+REGISTER_BENCH(alpha_blend_translucent) { bench_alpha_blend_colors(b, true); }
+
+// Screen position of i-th of SPRITE_DRAWS copies, spread over the screen and fully inside it
+static void draw_position(int i, uint32_t w, uint32_t h, int *x, int *y) {
+  *x = (int)((FB_W - w) * (uint32_t)(i % 8) / 8);
+  *y = (int)((FB_H - h) * (uint32_t)(i / 8) / (SPRITE_DRAWS / 8));
+}
+
+// render_sprite is a thin wrapper over blit_scaled, so the blit is measured directly
+static void bench_render_sprite_zoom(Bench *b, float zoom) {
+  uint32_t *fb = calloc(FB_W * FB_H, sizeof(uint32_t));
+  Sprite sprite = load_sprite("demo/assets/tree.png", 1.0f);
+  BENCH_REQUIRE(b, fb && sprite.pixels, "Failed to load demo/assets/tree.png");
+  uint32_t w = scaled_size(sprite.width, zoom), h = scaled_size(sprite.height, zoom);
+
+  bench_set_items(b, (uint64_t)SPRITE_DRAWS * w * h, "pixel");
+  BENCH_LOOP(b) {
+    for (int i = 0; i < SPRITE_DRAWS; i++) {
+      int x, y;
+      draw_position(i, w, h, &x, &y);
+      blit_scaled(fb, FB_W, FB_H, &sprite, x, y, zoom);
+    }
+  }
+  free_sprite(&sprite);
+  free(fb);
+}
+
+REGISTER_BENCH(render_sprite_zoom_1) { bench_render_sprite_zoom(b, 1.0f); }
+REGISTER_BENCH(render_sprite_zoom_2) { bench_render_sprite_zoom(b, 2.0f); }
+REGISTER_BENCH(render_sprite_zoom_0_5) { bench_render_sprite_zoom(b, 0.5f); }
+REGISTER_BENCH(render_sprite_zoom_1_5) { bench_render_sprite_zoom(b, 1.5f); }
+
+static void bench_render_shadow_zoom(Bench *b, float zoom) {
+  uint32_t *fb = calloc(FB_W * FB_H, sizeof(uint32_t));
+  Camera *camera = camera_create(FB_W, FB_H);
+  Sprite sprite = load_sprite("demo/assets/tree.png", 1.0f);
+  BENCH_REQUIRE(b, fb && camera && sprite.pixels, "Failed to load demo/assets/tree.png");
+  camera->zoom = zoom;
+  GameObject obj = {0};
+  obj.cur_sprite = &sprite;
+  uint32_t w = scaled_size(sprite.width, zoom), h = scaled_size(sprite.height, zoom);
+  uint32_t skewed_w = w + (uint32_t)(h * SHADOW_SKEW);
+
+  bench_set_items(b, (uint64_t)SPRITE_DRAWS * w * h, "pixel");
+  BENCH_LOOP(b) {
+    for (int i = 0; i < SPRITE_DRAWS; i++) {
+      int x, y;
+      draw_position(i, skewed_w, h, &x, &y);
+      render_shadow(fb, camera, &obj, camera_screen_to_world(camera, (Vector){(float)x, (float)y}));
+    }
+  }
+  free_sprite(&sprite);
+  camera_free(camera);
+  free(fb);
+}
+
+REGISTER_BENCH(render_shadow_zoom_1) { bench_render_shadow_zoom(b, 1.0f); }
+REGISTER_BENCH(render_shadow_zoom_2) { bench_render_shadow_zoom(b, 2.0f); }
+REGISTER_BENCH(render_shadow_zoom_0_5) { bench_render_shadow_zoom(b, 0.5f); }
+
+static GameObject *random_objects(Sprite *sprites, uint32_t count) {
+  GameObject *objs = calloc(count, sizeof(GameObject));
+  if (!objs) return NULL;
+  Rng rng;
+  rng_seed(&rng, 48);
+  for (uint32_t i = 0; i < count; i++) {
+    objs[i].position = (Vector){rng_float01(&rng) * 4000.0f, rng_float01(&rng) * 2000.0f};
+    objs[i].prev_position = objs[i].position;
+    objs[i].cur_sprite = &sprites[i % 2];
+  }
+  return objs;
+}
+
+// Depth sort of unsorted objects passed in the batch every frame
+REGISTER_BENCH(sort_batch_objects) {
+  Sprite sprites[2] = {{NULL, 32, 48}, {NULL, 64, 128}};
+  GameObject *objs = random_objects(sprites, SORT_OBJECTS);
+  GameObject **ptrs = malloc(SORT_OBJECTS * sizeof(GameObject *));
+  Arena *arena = arena_create(0);
+  BENCH_REQUIRE(b, objs && ptrs && arena, "Out of memory");
+  for (uint32_t i = 0; i < SORT_OBJECTS; i++) ptrs[i] = &objs[i];
+  RenderBatch batch = {0};
+  batch.objs = ptrs;
+  batch.obj_count = SORT_OBJECTS;
+
+  bench_set_items(b, SORT_OBJECTS, "object");
+  RenderShared shared = {0};
+  BENCH_LOOP(b) {
+    arena_reset(arena);
+    render_prepare_objects(&shared, &batch, arena, 1.0f);
+  }
+  bench_consume(shared.count);
+  arena_free(arena);
+  free(ptrs);
+  free(objs);
+}
+
+// Presorted static objects of a render list merged with a few sorted dynamic ones
+REGISTER_BENCH(sort_render_list_merge) {
+  Sprite sprites[2] = {{NULL, 32, 48}, {NULL, 64, 128}};
+  GameObject *objs = random_objects(sprites, SORT_OBJECTS + SORT_DYNAMIC);
+  RenderList *list = render_list_create();
+  Arena *arena = arena_create(0);
+  BENCH_REQUIRE(b, objs && list && arena, "Out of memory");
+  for (uint32_t i = 0; i < SORT_OBJECTS; i++) render_list_add_static(list, &objs[i]);
+  for (uint32_t i = 0; i < SORT_DYNAMIC; i++) render_list_add(list, &objs[SORT_OBJECTS + i]);
+  RenderBatch batch = {0};
+  batch.render_list = list;
+
+  bench_set_items(b, SORT_OBJECTS + SORT_DYNAMIC, "object");
+  RenderShared shared = {0};
+  BENCH_LOOP(b) {
+    arena_reset(arena);
+    render_prepare_objects(&shared, &batch, arena, 1.0f);
+  }
+  bench_consume(shared.count);
+  arena_free(arena);
+  render_list_free(list);
+  free(objs);
+}
@@ -0,0 +1,5 @@
+#include "bench_framework.h"
+
+int main(int argc, char **argv) {
+  return bench_runner_main(argc, argv);
+}
@@ -0,0 +1,59 @@
+#include "bench_framework.h"
+#include "stress_scene.h"
+
+// Whole frames of synthetic scenes. Every timed iteration is one frame, so the reported distribution
+// is the frame-time distribution, and ns/object over the object count sweep shows where scaling breaks.
+//
+// The sweep keeps the map size, so density grows with the object count: more objects are visible
+// and sorted every frame, which is what happens when a world is filled up.
+#define SWEEP_MAP_SIZE 64
+#define SWEEP_UI_COUNT 50
+
+static void run_stress(Bench *b, const StressConfig *config) {
+  StressScene *scene = stress_scene_create(config);
+  BENCH_REQUIRE(b, scene, "Failed to create stress scene");
+
+  bench_set_items(b, (uint64_t)config->static_count + config->dynamic_count, "object");
+  BENCH_LOOP(b) { stress_scene_frame(scene); }
+  stress_scene_free(scene);
+}
+
+// 'count' objects, 10% of them moving, with the camera panning over the map
+static void run_sweep(Bench *b, uint32_t count) {
+  StressConfig config = stress_config_default();
+  config.map_width = config.map_height = SWEEP_MAP_SIZE;
+  config.static_count = count - count / 10;
+  config.dynamic_count = count / 10;
+  config.ui_count = SWEEP_UI_COUNT;
+  config.camera_path = STRESS_PATH_PAN;
+  run_stress(b, &config);
+}
+
+REGISTER_BENCH(stress_objects_1k) { run_sweep(b, 1000); }
+REGISTER_BENCH(stress_objects_10k) { run_sweep(b, 10000); }
+REGISTER_BENCH(stress_objects_100k) {
+  bench_limit_repetitions(b, 3, 30);
+  run_sweep(b, 100000);
+}
+REGISTER_BENCH(stress_objects_1m) {
+  bench_limit_repetitions(b, 1, 10);
+  run_sweep(b, 1000000);
+}
+
+// Zoomed-out orbit: large visible area, sprites and map drawn from scaled sources
+REGISTER_BENCH(stress_zoomed_out_10k) {
+  StressConfig config = stress_config_default();
+  config.map_width = config.map_height = SWEEP_MAP_SIZE;
+  config.static_count = 9000;
+  config.dynamic_count = 1000;
+  config.camera_path = STRESS_PATH_ORBIT;
+  config.zoom = 0.25f;
+  run_stress(b, &config);
+}
+
+// Many UI elements, half of them attached to moving entities
+REGISTER_BENCH(stress_ui_1k) {
+  StressConfig config = stress_config_default();
+  config.ui_count = 1000;
+  run_stress(b, &config);
+}
@@ -0,0 +1,236 @@
+#include "stress_scene.h"
+#include <engine/random.h>
+#include <math.h>
+#include <stdlib.h>
+
+#define UPDATE_GRAIN 1024
+#define UI_BAR_W 32
+#define UI_BAR_H 6
+#define PI 3.14159265f
+
+StressConfig stress_config_default(void) {
+  StressConfig c = {0};
+  c.screen_width = 800;
+  c.screen_height = 600;
+  c.map_width = 25;
+  c.map_height = 25;
+  c.static_count = 900;
+  c.dynamic_count = 100;
+  c.sprite_min = 16;
+  c.sprite_max = 96;
+  c.sprite_variants = 8;
+  c.camera_path = STRESS_PATH_STILL;
+  c.path_frames = 120;
+  c.zoom = 1.0f;
+  c.seed = 49;
+  return c;
+}
+
+// Opaque ellipse with translucent edge, like an antialiased sprite
+static bool gen_sprite(Sprite *sprite, uint32_t w, uint32_t h, uint32_t rgb) {
+  sprite->width = w;
+  sprite->height = h;
+  sprite->pixels = malloc((size_t)w * h * sizeof(uint32_t));
+  if (!sprite->pixels) return false;
+  float rx = w / 2.0f, ry = h / 2.0f;
+  for (uint32_t y = 0; y < h; y++) {
+    for (uint32_t x = 0; x < w; x++) {
+      float dx = (x + 0.5f - rx) / rx, dy = (y + 0.5f - ry) / ry;
+      float d = dx * dx + dy * dy;
+      uint32_t a = d < 0.8f ? 255 : d < 1.0f ? (uint32_t)((1.0f - d) * 5.0f * 255.0f) : 0;
+      sprite->pixels[y * w + x] = (a << 24) | rgb;
+    }
+  }
+  return true;
+}
+
+static bool gen_sprites(StressScene *scene, Rng *rng) {
+  const StressConfig *c = &scene->config;
+  scene->sprites = calloc(c->sprite_variants + 1, sizeof(Sprite));
+  if (!scene->sprites) return false;
+  float log_min = logf((float)c->sprite_min), log_max = logf((float)c->sprite_max);
+  for (uint32_t i = 0; i < c->sprite_variants; i++) {
+    float t = c->sprite_variants > 1 ? (float)i / (c->sprite_variants - 1) : 0.0f;
+    uint32_t w = (uint32_t)expf(log_min + (log_max - log_min) * t);
+    if (!gen_sprite(&scene->sprites[i], w, w * 3 / 2, rng_next(rng) & 0x00FFFFFF)) return false;
+  }
+  Sprite *bar = &scene->sprites[c->sprite_variants];
+  if (!gen_sprite(bar, UI_BAR_W, UI_BAR_H, 0x00FF0000)) return false;
+  for (uint32_t i = 0; i < UI_BAR_W * UI_BAR_H; i++) bar->pixels[i] |= 0xFF000000;
+  return true;
+}
+
+// Random object sprite. Variants are equally likely, so sizes are log-uniform
+static Sprite *random_sprite(StressScene *scene, Rng *rng) {
+  return &scene->sprites[rng_range(rng, scene->config.sprite_variants)];
+}
+
+static Map *stress_map(const StressConfig *c) {
+  TilesInfo ti = {0};
+  ti.tile_sprites = calloc(1, sizeof(Sprite));
+  ti.tiles = calloc((size_t)c->map_width * c->map_height, sizeof(uint32_t));
+  if (!ti.tile_sprites || !ti.tiles) {
+    free(ti.tile_sprites);
+    free(ti.tiles);
+    return NULL;
+  }
+  ti.tile_sprites[0] = load_sprite("demo/assets/grass_high.png", 1.0f / 7.2f);
+  ti.sprite_count = 1;
+  ti.sides_height = 64;
+  return map_create(c->map_width, c->map_height, ti);
+}
+
+static bool add_objects(StressScene *scene, Rng *rng) {
+  const StressConfig *c = &scene->config;
+  uint32_t total = c->static_count + c->dynamic_count;
+  VectorU32 *positions = malloc((total + 1) * sizeof(VectorU32));
+  scene->statics = calloc(c->static_count + 1, sizeof(GameObject));
+  scene->render_list = render_list_create();
+  scene->entities = entity_store_create(c->dynamic_count + 1, 0);
+  if (!positions || !scene->statics || !scene->render_list || !scene->entities) {
+    free(positions);
+    return false;
+  }
+  rand_seed(c->seed);
+  map_gen_random_positions(scene->map, c->sprite_max, positions, total);
+
+  for (uint32_t i = 0; i < c->static_count; i++) {
+    GameObject *obj = &scene->statics[i];
+    obj->position = (Vector){(float)positions[i].x, (float)positions[i].y};
+    obj->prev_position = obj->position;
+    obj->cur_sprite = random_sprite(scene, rng);
+    render_list_add_static(scene->render_list, obj);
+  }
+  for (uint32_t i = 0; i < c->dynamic_count; i++) {
+    VectorU32 p = positions[c->static_count + i];
+    entity_store_add(scene->entities, (Vector){(float)p.x, (float)p.y}, random_sprite(scene, rng));
+    float angle = rng_float01(rng) * 2.0f * PI, speed = 0.5f + rng_float01(rng) * 1.5f;
+    scene->entities->velocities[i] = (Vector){cosf(angle) * speed, sinf(angle) * speed};
+  }
+  entity_store_sync_objects(scene->entities);
+  free(positions);
+  return true;
+}
+
+// Every second element is attached to an entity, the rest are laid out on the screen in a grid
+static bool add_uis(StressScene *scene) {
+  const StressConfig *c = &scene->config;
+  scene->ui_layer = ui_layer_create();
+  scene->uis = calloc(c->ui_count + 1, sizeof(UIElement));
+  if (!scene->ui_layer || !scene->uis) return false;
+  uint32_t columns = c->screen_width / (UI_BAR_W + 4);
+  for (uint32_t i = 0; i < c->ui_count; i++) {
+    UIElement *ui = &scene->uis[i];
+    ui->sprite = &scene->sprites[c->sprite_variants];
+    ui->z_index = (int)(i % 4);
+    if (i % 2 && c->dynamic_count > 0) {
+      ui->mode = UI_POS_ATTACHED;
+      ui->position.attached.object = entity_store_object_at(scene->entities, (i / 2) % c->dynamic_count);
+      ui->position.attached.offset = (Vector){0.0f, -8.0f};
+    } else {
+      uint32_t cell = i / 2;
+      ui->mode = UI_POS_SCREEN;
+      ui->position.screen = (Vector){(float)(cell % columns * (UI_BAR_W + 4)), (float)(cell / columns * 8)};
+    }
+    if (!ui_layer_add(scene->ui_layer, ui)) return false;
+  }
+  return true;
+}
+
+// Point of the camera path at given frame
+static Vector path_point(const StressScene *scene, uint32_t frame) {
+  VectorU32 size = map_get_size(scene->map);
+  Vector center = {size.x / 2.0f, size.y / 2.0f};
+  float t = (float)(frame % scene->config.path_frames) / scene->config.path_frames;
+  switch (scene->config.camera_path) {
+  case STRESS_PATH_PAN: {
+    float along = t < 0.5f ? t * 2.0f : 2.0f - t * 2.0f; // there and back
+    return (Vector){size.x * (0.1f + 0.8f * along), center.y};
+  }
+  case STRESS_PATH_ORBIT: {
+    float angle = t * 2.0f * PI;
+    return (Vector){center.x + cosf(angle) * size.x / 4.0f, center.y + sinf(angle) * size.y / 4.0f};
+  }
+  case STRESS_PATH_STILL:
+  default:
+    return center;
+  }
+}
+
+StressScene *stress_scene_create(const StressConfig *config) {
+  StressScene *scene = calloc(1, sizeof(StressScene));
+  if (!scene) return NULL;
+  scene->config = config ? *config : stress_config_default();
+  StressConfig *c = &scene->config;
+  if (c->sprite_variants == 0) c->sprite_variants = 1;
+  if (c->sprite_min == 0) c->sprite_min = 1;
+  if (c->sprite_max < c->sprite_min) c->sprite_max = c->sprite_min;
+  if (c->path_frames == 0) c->path_frames = 1;
+
+  Rng rng;
+  rng_seed(&rng, c->seed);
+  scene->engine = engine_create_headless((int)c->screen_width, (int)c->screen_height);
+  scene->map = stress_map(c);
+  if (!scene->engine || !scene->map || !gen_sprites(scene, &rng) || !add_objects(scene, &rng) ||
+      !add_uis(scene)) {
+    stress_scene_free(scene);
+    return NULL;
+  }
+  scene->batch.render_list = scene->render_list;
+  scene->batch.entities = scene->entities;
+  scene->batch.ui_layer = scene->ui_layer;
+
+  engine_set_map(scene->engine, scene->map);
+  scene->camera_target.position = path_point(scene, 0);
+  engine_set_player(scene->engine, &scene->camera_target);
+  engine_set_zoom(scene->engine, c->zoom);
+  engine_snap_view(scene->engine, 0);
+  return scene;
+}
+
+void stress_scene_free(StressScene *scene) {
+  if (!scene) return;
+  engine_free(scene->engine);
+  ui_layer_free(scene->ui_layer);
+  free(scene->uis);
+  entity_store_free(scene->entities);
+  render_list_free(scene->render_list);
+  free(scene->statics);
+  if (scene->sprites) free_sprites(scene->sprites, scene->config.sprite_variants + 1);
+  map_free(scene->map);
+  free(scene);
+}
+
+// Straight movement, bouncing off the map bounding rectangle
+static void move_entities(EntityStore *store,
+    uint32_t begin,
+    uint32_t end,
+    uint32_t worker,
+    void *user_data) {
+  (void)worker;
+  VectorU32 size = *(const VectorU32 *)user_data;
+  for (uint32_t i = begin; i < end; i++) {
+    Vector *p = &store->positions[i], *v = &store->velocities[i];
+    p->x += v->x;
+    p->y += v->y;
+    if (p->x < 0.0f || p->x + store->sprites[i]->width > size.x) v->x = -v->x;
+    if (p->y < 0.0f || p->y + store->sprites[i]->height > size.y) v->y = -v->y;
+  }
+}
+
+static void stress_update(Input *input, void *user_data) {
+  (void)input;
+  StressScene *scene = user_data;
+  VectorU32 size = map_get_size(scene->map);
+  JobSystem *jobs = engine_get_jobs(scene->engine);
+  entity_store_run_parallel(scene->entities, jobs, UPDATE_GRAIN, move_entities, &size);
+  entity_store_sync_objects(scene->entities);
+}
+
+void stress_scene_frame(StressScene *scene) {
+  if (!scene) return;
+  scene->camera_target.position = path_point(scene, ++scene->frame);
+  engine_begin_frame(scene->engine, stress_update, scene);
+  engine_render(scene->engine, &scene->batch);
+  engine_end_frame(scene->engine);
+}
@@ -0,0 +1,60 @@
+#ifndef STRESS_SCENE_H
+#define STRESS_SCENE_H
+
+#include <engine/engine.h>
+#include <engine/entity.h>
+#include <engine/map.h>
+#include <engine/render_list.h>
+#include <engine/types.h>
+#include <engine/ui.h>
+#include <stdint.h>
+
+// Path of the main view over the frames of a run
+typedef enum {
+  STRESS_PATH_STILL, // map center
+  STRESS_PATH_PAN,   // along the map diagonal and back
+  STRESS_PATH_ORBIT, // circle around the map center
+} StressCameraPath;
+
+// Synthetic scene parameters. Everything random is determined by 'seed'.
+typedef struct {
+  uint32_t screen_width, screen_height;
+  uint32_t map_width, map_height; // tiles
+  uint32_t static_count;          // never move, registered in a render list
+  uint32_t dynamic_count;         // entities moving every logic step
+  // Sprite sizes: 'sprite_variants' generated sprites with widths spread log-uniformly
+  // over [sprite_min, sprite_max], so small sprites are more common. Height is 1.5x width.
+  uint32_t sprite_min, sprite_max;
+  uint32_t sprite_variants;
+  uint32_t ui_count; // retained UI elements, every second one attached to an entity
+  StressCameraPath camera_path;
+  uint32_t path_frames; // frames for one pass of the path
+  float zoom;
+  uint64_t seed;
+} StressConfig;
+
+typedef struct {
+  StressConfig config;
+  Engine *engine;
+  Map *map;
+  Sprite *sprites; // 'sprite_variants' object sprites, then UI sprite
+  GameObject *statics;
+  RenderList *render_list;
+  EntityStore *entities;
+  UIElement *uis;
+  UILayer *ui_layer;
+  RenderBatch batch;
+  GameObject camera_target;
+  uint32_t frame;
+} StressScene;
+
+// Defaults: demo-sized screen and map, 1000 objects, 10% of them moving, no UI, still camera.
+StressConfig stress_config_default(void);
+
+// Build headless engine with the scene. Returns NULL on allocation failure.
+StressScene *stress_scene_create(const StressConfig *config);
+void stress_scene_free(StressScene *scene);
+// Run one frame: move the camera along its path, one logic step for entities, render all views.
+void stress_scene_frame(StressScene *scene);
+
+#endif
@@ -1,22 +1,27 @@
 #include "dyn_objs.h"
+#include <engine/collision.h>
 #include <engine/coordinates.h>
+#include <engine/entity.h>
 #include <engine/input.h>
 #include <engine/map.h>
 #include <engine/random.h>
+#include <engine/spatial_hash.h>
 #include <engine/types.h>
 #include <math.h>
-#include <stb_ds.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define ANIM_FRAME_TIME (1.0f / 8.0f) // in seconds
+#define ANIM_FRAME_MS 125 // 8 frames per second
 #define MAN_COUNT 5
 #define SHEEPS_COUNT 30
 #define PLAYER_SPEED 3.5f
+#define SHEEP_PERSONAL_SPACE 40.0f // Sheeps step away from neighbours closer than that
+#define NEIGHBOURS_MAX 16
+#define UPDATE_GRAIN 512 // Entities per parallel update task
 
-typedef enum { ANIM_IDLE = 0, ANIM_WALK } AnimState;
+typedef enum { ANIM_IDLE = 0, ANIM_WALK, ANIM_STATE_COUNT } AnimState;
 
-typedef enum { DIR_FORWARD = 0, DIR_BACK, DIR_LEFT, DIR_RIGHT } Direction;
+typedef enum { DIR_FORWARD = 0, DIR_BACK, DIR_LEFT, DIR_RIGHT, DIR_COUNT } Direction;
 
 typedef enum { TYPE_MAN = 0, TYPE_SHEEP, TYPE_COUNT } EntityType;
 
@@ -25,30 +30,41 @@ typedef struct {
   Sprite *all_frames; // All sprite frames
   int frame_count;    // Total number of frames
 
-  // Animation clips: [state][direction] -> start_index, count
-  struct {
-    int start;   // index of first frame
-    int count;   // number of frames
-  } clips[2][4]; // [ANIM_IDLE/WALK][DIR_FORWARD/BACK/LEFT/RIGHT]
+  // Animation clips, indexed by ANIM_CLIP(state, direction)
+  AnimClip clips[ANIM_STATE_COUNT * DIR_COUNT];
+  uint16_t anim_set; // Index of animation set in animator
 } EntitySprites;
 
 typedef struct DynamicObjects {
   EntitySprites *sprites;
-  GameObject *objects;
-  GameObject *player;
+  EntityStore *store; // Entities with EntityType as user component
+  SpatialHash *grid;  // Entity positions for neighbour queries, rebuilt every update
+  Handle player;      // Player entity
   Map *map;
+
+  JobSystem *jobs;
+  Vector *steps;  // Position change of every entity for current update
+  uint64_t seed;  // Base seed of npc random movements
+  uint64_t ticks; // Number of updates done
+
+  CollisionWorld *collisions;
+  Rect *footprints; // Footprints of entities, used for collisions
+
+  Animator *animator;
 } DynamicObjects;
 
-// Object animation data
-typedef struct {
-  EntityType type;
-  EntitySprites *sprites;
+// Animation clip index for (state, direction). Clips of all entity types are laid out the same way,
+// so the state table of animation sets is the same identity table.
+#define ANIM_CLIP(state, dir) ((uint16_t)((state) * DIR_COUNT + (dir)))
+#define CLIP_DIR(clip) ((Direction)((clip) % DIR_COUNT))
+
+static const uint16_t state_clips[ANIM_STATE_COUNT * DIR_COUNT] = {0, 1, 2, 3, 4, 5, 6, 7};
 
-  AnimState state;
-  Direction direction;
-  int frame_in_anim; // number of current animation frame
-  float timer;
-} EntityData;
+// Set looping clip for given state and direction
+static void set_clip(EntitySprites *sprs, AnimState state, Direction dir, uint16_t start, uint16_t count) {
+  uint16_t idx = ANIM_CLIP(state, dir);
+  sprs->clips[idx] = (AnimClip){start, count, ANIM_FRAME_MS, idx};
+}
 
 // Load man sprites from spritesheets
 static EntitySprites create_man_sprites() {
@@ -83,23 +99,15 @@ static EntitySprites create_man_sprites() {
 
   sprs.frame_count = walk_count + idle_count;
 
-  sprs.clips[ANIM_IDLE][DIR_BACK].start = 0;
-  sprs.clips[ANIM_IDLE][DIR_BACK].count = 12;
-  sprs.clips[ANIM_IDLE][DIR_LEFT].start = 12;
-  sprs.clips[ANIM_IDLE][DIR_LEFT].count = 12;
-  sprs.clips[ANIM_IDLE][DIR_RIGHT].start = 24;
-  sprs.clips[ANIM_IDLE][DIR_RIGHT].count = 12;
-  sprs.clips[ANIM_IDLE][DIR_FORWARD].start = 36;
-  sprs.clips[ANIM_IDLE][DIR_FORWARD].count = 4;
-
-  sprs.clips[ANIM_WALK][DIR_BACK].start = 40;
-  sprs.clips[ANIM_WALK][DIR_BACK].count = 6;
-  sprs.clips[ANIM_WALK][DIR_LEFT].start = 46;
-  sprs.clips[ANIM_WALK][DIR_LEFT].count = 6;
-  sprs.clips[ANIM_WALK][DIR_RIGHT].start = 52;
-  sprs.clips[ANIM_WALK][DIR_RIGHT].count = 6;
-  sprs.clips[ANIM_WALK][DIR_FORWARD].start = 58;
-  sprs.clips[ANIM_WALK][DIR_FORWARD].count = 6;
+  set_clip(&sprs, ANIM_IDLE, DIR_BACK, 0, 12);
+  set_clip(&sprs, ANIM_IDLE, DIR_LEFT, 12, 12);
+  set_clip(&sprs, ANIM_IDLE, DIR_RIGHT, 24, 12);
+  set_clip(&sprs, ANIM_IDLE, DIR_FORWARD, 36, 4);
+
+  set_clip(&sprs, ANIM_WALK, DIR_BACK, 40, 6);
+  set_clip(&sprs, ANIM_WALK, DIR_LEFT, 46, 6);
+  set_clip(&sprs, ANIM_WALK, DIR_RIGHT, 52, 6);
+  set_clip(&sprs, ANIM_WALK, DIR_FORWARD, 58, 6);
 
   return sprs;
 }
@@ -119,137 +127,139 @@ static EntitySprites create_sheep_sprites() {
 
   // Setup animation clips
   // Walk animations (6 frames each)
-  sprs.clips[ANIM_WALK][DIR_BACK].start = 0;
-  sprs.clips[ANIM_WALK][DIR_BACK].count = 6;
-  sprs.clips[ANIM_WALK][DIR_FORWARD].start = 6;
-  sprs.clips[ANIM_WALK][DIR_FORWARD].count = 6;
-  sprs.clips[ANIM_WALK][DIR_LEFT].start = 12;
-  sprs.clips[ANIM_WALK][DIR_LEFT].count = 6;
-  sprs.clips[ANIM_WALK][DIR_RIGHT].start = 18;
-  sprs.clips[ANIM_WALK][DIR_RIGHT].count = 6;
+  set_clip(&sprs, ANIM_WALK, DIR_BACK, 0, 6);
+  set_clip(&sprs, ANIM_WALK, DIR_FORWARD, 6, 6);
+  set_clip(&sprs, ANIM_WALK, DIR_LEFT, 12, 6);
+  set_clip(&sprs, ANIM_WALK, DIR_RIGHT, 18, 6);
 
   // Idle animations (4 frames each)
-  sprs.clips[ANIM_IDLE][DIR_BACK].start = 24;
-  sprs.clips[ANIM_IDLE][DIR_BACK].count = 4;
-  sprs.clips[ANIM_IDLE][DIR_FORWARD].start = 30;
-  sprs.clips[ANIM_IDLE][DIR_FORWARD].count = 4;
-  sprs.clips[ANIM_IDLE][DIR_LEFT].start = 36;
-  sprs.clips[ANIM_IDLE][DIR_LEFT].count = 4;
-  sprs.clips[ANIM_IDLE][DIR_RIGHT].start = 42;
-  sprs.clips[ANIM_IDLE][DIR_RIGHT].count = 4;
+  set_clip(&sprs, ANIM_IDLE, DIR_BACK, 24, 4);
+  set_clip(&sprs, ANIM_IDLE, DIR_FORWARD, 30, 4);
+  set_clip(&sprs, ANIM_IDLE, DIR_LEFT, 36, 4);
+  set_clip(&sprs, ANIM_IDLE, DIR_RIGHT, 42, 4);
 
   return sprs;
 }
 
-static GameObject *gen_dyn_objects(DynamicObjects *dyn_objs) {
-  GameObject *objects = NULL;
+static inline EntityType entity_type(EntityStore *store, uint32_t idx) {
+  return *(EntityType *)entity_store_user(store, idx);
+}
+
+static Handle add_entity(DynamicObjects *dyn_objs, EntityType type, Vector position) {
+  EntityStore *store = dyn_objs->store;
+  Handle entity = entity_store_add(store, position, NULL);
+  if (entity.generation == 0) return entity;
+  uint32_t idx = store->count - 1;
+
+  *(EntityType *)entity_store_user(store, idx) = type;
+  // Initial sprite is the first frame of idle animation
+  EntityAnim *anim = &store->anims[idx];
+  animator_start(dyn_objs->animator, anim, &store->sprites[idx], dyn_objs->sprites[type].anim_set);
+  animator_set_state(dyn_objs->animator, anim, &store->sprites[idx], ANIM_IDLE, DIR_BACK);
+  return entity;
+}
 
+static bool register_anim_set(Animator *animator, EntitySprites *sprs) {
+  AnimSet set = {0};
+  set.frames = sprs->all_frames;
+  set.clips = sprs->clips;
+  set.clip_count = ANIM_STATE_COUNT * DIR_COUNT;
+  set.state_clips = state_clips;
+  set.state_count = ANIM_STATE_COUNT;
+  set.variant_count = DIR_COUNT;
+  sprs->anim_set = animator_add_set(animator, set);
+  return sprs->anim_set != ANIM_SET_NONE;
+}
+
+static bool gen_dyn_objects(DynamicObjects *dyn_objs) {
   if (!dyn_objs || !dyn_objs->map || !dyn_objs->sprites[TYPE_MAN].all_frames ||
       !dyn_objs->sprites[TYPE_SHEEP].all_frames)
-    return NULL;
+    return false;
   VectorU32 map_size = map_get_size(dyn_objs->map);
 
   for (int i = 0; i < MAN_COUNT; i++) {
-    GameObject man = {0};
-
     int x = map_size.x / 2 + i * 100;
     int y = map_size.y / 2;
-    man.position = (Vector){(float)x, (float)y};
-
-    // Create entity data
-    EntityData *data = calloc(1, sizeof(EntityData));
-    data->type = TYPE_MAN;
-    data->sprites = &dyn_objs->sprites[TYPE_MAN];
-    data->state = ANIM_IDLE;
-    data->direction = DIR_BACK;
-    data->frame_in_anim = 0;
-    data->timer = 0.0f;
-
-    man.data = data;
-    man.pos_delta = (Vector){0, 0};
-
-    // Set initial sprite
-    man.cur_sprite =
-        &dyn_objs->sprites[TYPE_MAN].all_frames[dyn_objs->sprites[TYPE_MAN].clips[ANIM_IDLE][DIR_BACK].start];
-
-    arrpush(objects, man);
+    Handle man = add_entity(dyn_objs, TYPE_MAN, (Vector){(float)x, (float)y});
+    if (i == 0) dyn_objs->player = man; // first man
   }
 
-  // Create sheeps
+  // Create sheeps at random positions around the map
+  VectorU32 positions[SHEEPS_COUNT];
+  map_gen_random_positions(dyn_objs->map, 100, positions, SHEEPS_COUNT);
   for (int i = 0; i < SHEEPS_COUNT; i++) {
-    GameObject sheep = {0};
-
-    // Random positions around the map
-    VectorU32 pos = map_gen_random_position(dyn_objs->map, 100);
-    sheep.position = (Vector){(float)pos.x, (float)pos.y};
-
-    EntityData *data = calloc(1, sizeof(EntityData));
-    data->type = TYPE_SHEEP;
-    data->sprites = &dyn_objs->sprites[TYPE_SHEEP];
-    data->state = ANIM_IDLE;
-    data->direction = DIR_BACK;
-    data->frame_in_anim = 0;
-    data->timer = 0.0f;
-
-    sheep.data = data;
-    sheep.pos_delta = (Vector){0, 0};
-
-    // Set initial sprite
-    sheep.cur_sprite = &dyn_objs->sprites[TYPE_SHEEP]
-                            .all_frames[dyn_objs->sprites[TYPE_SHEEP].clips[ANIM_IDLE][DIR_BACK].start];
-
-    arrpush(objects, sheep);
+    add_entity(dyn_objs, TYPE_SHEEP, (Vector){(float)positions[i].x, (float)positions[i].y});
   }
 
-  return objects;
+  return true;
 }
 
-DynamicObjects *create_dynamic_objects(Map *map) {
+DynamicObjects *create_dynamic_objects(Map *map, JobSystem *jobs) {
   if (!map) return NULL;
   DynamicObjects *dyn_objs = calloc(1, sizeof(DynamicObjects));
   if (!dyn_objs) return NULL;
   dyn_objs->map = map;
+  dyn_objs->jobs = jobs;
+  dyn_objs->seed = ((uint64_t)rand_big() << 32) | rand_big();
 
   dyn_objs->sprites = calloc(TYPE_COUNT, sizeof(EntitySprites));
-  if (!dyn_objs->sprites) {
-    free(dyn_objs);
+  dyn_objs->store = entity_store_create(MAN_COUNT + SHEEPS_COUNT, sizeof(EntityType));
+  dyn_objs->grid = spatial_hash_create(SHEEP_PERSONAL_SPACE, MAN_COUNT + SHEEPS_COUNT);
+  dyn_objs->steps = calloc(MAN_COUNT + SHEEPS_COUNT, sizeof(Vector));
+  dyn_objs->collisions = collision_create(MAN_COUNT + SHEEPS_COUNT);
+  dyn_objs->footprints = calloc(MAN_COUNT + SHEEPS_COUNT, sizeof(Rect));
+  dyn_objs->animator = animator_create();
+  if (!dyn_objs->sprites || !dyn_objs->store || !dyn_objs->grid || !dyn_objs->steps ||
+      !dyn_objs->collisions || !dyn_objs->footprints || !dyn_objs->animator) {
+    free_dyn_objects(dyn_objs);
     return NULL;
   }
 
   dyn_objs->sprites[TYPE_MAN] = create_man_sprites();
   dyn_objs->sprites[TYPE_SHEEP] = create_sheep_sprites();
+  bool registered = true;
+  for (int i = 0; i < TYPE_COUNT; i++) {
+    registered = registered && register_anim_set(dyn_objs->animator, &dyn_objs->sprites[i]);
+  }
 
-  dyn_objs->objects = gen_dyn_objects(dyn_objs);
-  dyn_objs->player = &dyn_objs->objects[0]; // first man
-
+  if (!registered || !gen_dyn_objects(dyn_objs)) {
+    free_dyn_objects(dyn_objs);
+    return NULL;
+  }
   return dyn_objs;
 }
 
 void free_dyn_objects(DynamicObjects *dyn_objs) {
   if (!dyn_objs) return;
 
-  for (int i = 0; i < TYPE_COUNT; i++) {
-    if (dyn_objs->sprites[i].all_frames) {
-      free_sprites(dyn_objs->sprites[i].all_frames, dyn_objs->sprites[i].frame_count);
+  if (dyn_objs->sprites) {
+    for (int i = 0; i < TYPE_COUNT; i++) {
+      if (dyn_objs->sprites[i].all_frames) {
+        free_sprites(dyn_objs->sprites[i].all_frames, dyn_objs->sprites[i].frame_count);
+      }
     }
   }
 
   free(dyn_objs->sprites);
-  arrfree(dyn_objs->objects);
+  entity_store_free(dyn_objs->store);
+  spatial_hash_free(dyn_objs->grid);
+  free(dyn_objs->steps);
+  collision_free(dyn_objs->collisions);
+  free(dyn_objs->footprints);
+  animator_free(dyn_objs->animator);
   free(dyn_objs);
 }
 
 GameObject *dyn_objs_get_player(DynamicObjects *dyn_objs) {
   if (!dyn_objs) return NULL;
-  return dyn_objs->player;
+  return entity_store_object(dyn_objs->store, dyn_objs->player);
 }
 
-GameObject *dyn_objs_get_objects(DynamicObjects *dyn_objs) {
-  if (!dyn_objs) return NULL;
-  return dyn_objs->objects;
+EntityStore *dyn_objs_get_store(DynamicObjects *dyn_objs) {
+  return dyn_objs ? dyn_objs->store : NULL;
 }
 
-static void player_update_pos_delta(Input *input, GameObject *player) {
+static void player_update_pos_delta(Input *input, Vector *velocity) {
   float ax = 0.0f, ay = 0.0f;
   if (input->a) ax -= 1.0f;
   if (input->d) ax += 1.0f;
@@ -264,20 +274,20 @@ static void player_update_pos_delta(Input *input, GameObject *player) {
   }
 
   // Update position change
-  player->pos_delta.x = ax * PLAYER_SPEED;
-  player->pos_delta.y = ay * PLAYER_SPEED;
+  velocity->x = ax * PLAYER_SPEED;
+  velocity->y = ay * PLAYER_SPEED;
 }
 
 // Just some random movements for npc
-static void npc_update_pos_delta(GameObject *npc) {
-  Vector oldv = npc->pos_delta;
+static void npc_update_pos_delta(Rng *rng, Vector *velocity) {
+  Vector oldv = *velocity;
   float spd = sqrtf(oldv.x * oldv.x + oldv.y * oldv.y);
   float moving = spd >= 0.1f; // 1 if moving, 0 if standing
 
   // Probability to keep current state 0.99 (walking/standing)
-  float keep = rand_big() % 100 < 99;
+  float keep = rng_range(rng, 100) < 99;
 
-  float angle = ((float)rand_big() / 100.0f) * 6.0f;
+  float angle = ((float)rng_next(rng) / 100.0f) * 6.0f;
   Vector rand_dir = {cosf(angle), sinf(angle)};
 
   Vector newv = {keep * oldv.x + (1 - keep) * (moving * rand_dir.x * spd),
@@ -286,99 +296,129 @@ static void npc_update_pos_delta(GameObject *npc) {
   newv.x += (1 - moving) * (1 - keep) * rand_dir.x;
   newv.y += (1 - moving) * (1 - keep) * rand_dir.y;
 
-  npc->pos_delta = newv;
+  *velocity = newv;
 }
 
 // Npc runs away from player when too close
-static void npc_run_away(GameObject *player, GameObject *npc) {
-  float dx = player->position.x - npc->position.x;
-  float dy = player->position.y - npc->position.y;
+static void npc_run_away(Vector player_pos, Vector npc_pos, Vector *velocity) {
+  float dx = player_pos.x - npc_pos.x;
+  float dy = player_pos.y - npc_pos.y;
   float dist = sqrtf(dx * dx + dy * dy);
   if (dist < 100.0f) {
     if (dist < 1.0f) { dist = 1.0f; }
-    npc->pos_delta.x = -(dx / dist) * 2.0f;
-    npc->pos_delta.y = -(dy / dist) * 2.0f;
+    velocity->x = -(dx / dist) * 2.0f;
+    velocity->y = -(dy / dist) * 2.0f;
   } else {
-    npc->pos_delta.x = 0.0f;
-    npc->pos_delta.y = 0.0f;
+    velocity->x = 0.0f;
+    velocity->y = 0.0f;
   }
 }
 
-// Update animation and set sprite
-static void update_object_animation(GameObject *obj) {
-  if (!obj) return;
-  EntityData *data = (EntityData *)obj->data;
-  if (!data || !data->sprites) return;
-
-  int clip_start = data->sprites->clips[data->state][data->direction].start;
-  int clip_count = data->sprites->clips[data->state][data->direction].count;
-  if (clip_count == 0) return;
-
-  if (data->timer >= ANIM_FRAME_TIME) {
-    data->timer = 0.0f;
-    data->frame_in_anim = (data->frame_in_anim + 1) % clip_count;
+// Sheeps don't like crowds: returns a push away from neighbours that are too close
+static Vector sheep_keep_distance(SpatialHash *grid, const Vector *positions, uint32_t self) {
+  uint32_t near[NEIGHBOURS_MAX];
+  uint32_t n = spatial_hash_query_radius(grid, positions[self], SHEEP_PERSONAL_SPACE, near, NEIGHBOURS_MAX);
+
+  Vector push = {0.0f, 0.0f};
+  for (uint32_t k = 0; k < n; k++) {
+    if (near[k] == self) continue;
+    float dx = positions[self].x - positions[near[k]].x;
+    float dy = positions[self].y - positions[near[k]].y;
+    float dist = sqrtf(dx * dx + dy * dy);
+    if (dist < 1.0f) continue;
+    // The closer neighbour is, the stronger push
+    float strength = (1.0f - dist / SHEEP_PERSONAL_SPACE) / dist;
+    push.x += dx * strength;
+    push.y += dy * strength;
   }
-
-  // Set current sprite
-  int sprite_index = clip_start + data->frame_in_anim;
-  obj->cur_sprite = &data->sprites->all_frames[sprite_index];
+  return push;
 }
 
-typedef struct Quadrangle {
-  Vector bl, br, tl, tr;
-} Quadrangle;
-
-static inline bool is_obj_base_within_map(Map *map, GameObject *obj) {
+static inline bool is_obj_base_within_map(Map *map, Vector position, Sprite *sprite) {
   if (!map) return false;
-  float x_offset = obj->cur_sprite->width * 0.3f;
-  float y_offset = obj->cur_sprite->height * 0.1f;
+  Rect base = object_footprint(position, sprite);
 
-  Vector bl = (Vector){obj->position.x + x_offset, obj->position.y + obj->cur_sprite->height};
-  Vector br = (Vector){obj->position.x + obj->cur_sprite->width - x_offset,
-      obj->position.y + obj->cur_sprite->height};
-  Vector tl = (Vector){bl.x, bl.y - y_offset};
-  Vector tr = (Vector){br.x, br.y - y_offset};
+  Vector tl = base.pos;
+  Vector tr = (Vector){base.pos.x + base.w, base.pos.y};
+  Vector bl = (Vector){base.pos.x, base.pos.y + base.h};
+  Vector br = (Vector){base.pos.x + base.w, base.pos.y + base.h};
 
   return is_point_within_map(map, bl, 0) && is_point_within_map(map, br, 0) &&
       is_point_within_map(map, tl, 0) && is_point_within_map(map, tr, 0);
 }
 
 // Update object position considering map boundaries
-static void safe_pos_update(Map *map, GameObject *obj) {
-  if (!obj) return;
-
-  Vector old_pos = obj->position;
-  obj->position.x += obj->pos_delta.x;
-  if (!is_obj_base_within_map(map, obj)) { obj->position.x = old_pos.x; }
-  obj->position.y += obj->pos_delta.y;
-  if (!is_obj_base_within_map(map, obj)) { obj->position.y = old_pos.y; }
-  return;
+static void safe_pos_update(Map *map, Vector *position, Vector velocity, Sprite *sprite) {
+  Vector old_pos = *position;
+  position->x += velocity.x;
+  if (!is_obj_base_within_map(map, *position, sprite)) { position->x = old_pos.x; }
+  position->y += velocity.y;
+  if (!is_obj_base_within_map(map, *position, sprite)) { position->y = old_pos.y; }
 }
 
-void dyn_objs_update(DynamicObjects *dyn_objs, Input *input, float delta_time) {
-  if (!dyn_objs || !input) return;
-
-  for (int i = 0; i < arrlen(dyn_objs->objects); i++) {
-    GameObject *obj = &dyn_objs->objects[i];
-    if (!obj || !obj->data) continue;
-    EntityData *data = (EntityData *)obj->data;
-    data->timer += delta_time;
-
-    if (obj == dyn_objs->player) {
-      player_update_pos_delta(input, obj);
-    } else if (data->type == TYPE_MAN) {
-      npc_run_away(dyn_objs->player, obj);
-    } else if (data->type == TYPE_SHEEP) {
-      npc_update_pos_delta(obj);
+typedef struct {
+  DynamicObjects *dyn_objs;
+  Input *input;
+  float delta_time;
+  uint32_t player; // index of the player entity, ENTITY_NONE if there is no player
+} UpdateContext;
+
+// First update phase: choose where every entity goes.
+// Reads positions of other entities, so positions are not changed here.
+static void think_entities(EntityStore *store,
+    uint32_t begin,
+    uint32_t end,
+    uint32_t worker,
+    void *user_data) {
+  (void)worker;
+  UpdateContext *ctx = (UpdateContext *)user_data;
+  DynamicObjects *dyn_objs = ctx->dyn_objs;
+
+  // Random stream depends only on tick and range, not on the thread that runs it,
+  // so the result is the same for any number of workers.
+  Rng rng;
+  rng_seed(&rng, dyn_objs->seed ^ (dyn_objs->ticks * 0x9E3779B97F4A7C15ull + begin));
+
+  for (uint32_t i = begin; i < end; i++) {
+    EntityType type = entity_type(store, i);
+    Vector *vel = &store->velocities[i];
+    Vector push = {0.0f, 0.0f};
+
+    if (i == ctx->player) {
+      player_update_pos_delta(ctx->input, vel);
+    } else if (type == TYPE_MAN && ctx->player != ENTITY_NONE) {
+      npc_run_away(store->positions[ctx->player], store->positions[i], vel);
+    } else if (type == TYPE_SHEEP) {
+      npc_update_pos_delta(&rng, vel);
+      push = sheep_keep_distance(dyn_objs->grid, store->positions, i);
     }
 
-    float dx = obj->pos_delta.x;
-    float dy = obj->pos_delta.y;
+    dyn_objs->steps[i] = (Vector){vel->x + push.x, vel->y + push.y};
+  }
+}
+
+// Second update phase: move entities and update their animations.
+// Touches only own components of every entity.
+static void move_entities(EntityStore *store,
+    uint32_t begin,
+    uint32_t end,
+    uint32_t worker,
+    void *user_data) {
+  (void)worker;
+  UpdateContext *ctx = (UpdateContext *)user_data;
+  DynamicObjects *dyn_objs = ctx->dyn_objs;
+
+  for (uint32_t i = begin; i < end; i++) {
+    EntityAnim *anim = &store->anims[i];
+    Vector *vel = &store->velocities[i];
+
+    float dx = vel->x;
+    float dy = vel->y;
     bool moving = fabs(dx) + fabs(dy) > 0.1f;
     AnimState n_st = moving ? ANIM_WALK : ANIM_IDLE;
-    Direction n_dir = data->direction;
+    Direction n_dir = CLIP_DIR(anim->clip);
     if (!moving) {
-      n_dir = data->direction;
+      n_dir = CLIP_DIR(anim->clip);
     } else if (fabs(dy) > fabs(dx) && dy > 0.1f) {
       n_dir = DIR_BACK;
     } else if (fabs(dy) > fabs(dx) && dy < -0.1f) {
@@ -388,12 +428,65 @@ void dyn_objs_update(DynamicObjects *dyn_objs, Input *input, float delta_time) {
     } else if (fabs(dy) < fabs(dx) && dx < -0.1f) {
       n_dir = DIR_LEFT;
     }
-    if (n_st != data->state) { data->frame_in_anim = 0; }
-    if (n_dir != data->direction) { data->frame_in_anim = 0; }
-    data->state = n_st;
-    data->direction = n_dir;
-    safe_pos_update(dyn_objs->map, obj);
+    animator_set_state(dyn_objs->animator, anim, &store->sprites[i], n_st, n_dir);
+    safe_pos_update(dyn_objs->map, &store->positions[i], dyn_objs->steps[i], store->sprites[i]);
+  }
+}
+
+// Third update phase: advance animation frames of all entities
+static void animate_entities(EntityStore *store,
+    uint32_t begin,
+    uint32_t end,
+    uint32_t worker,
+    void *user_data) {
+  (void)worker;
+  UpdateContext *ctx = (UpdateContext *)user_data;
+  animator_advance(ctx->dyn_objs->animator, &store->anims[begin], &store->sprites[begin], end - begin);
+}
+
+// Move entity by given shift if it stays within the map
+static void try_shift(Map *map, EntityStore *store, uint32_t idx, Vector shift) {
+  Vector pos = {store->positions[idx].x + shift.x, store->positions[idx].y + shift.y};
+  if (is_obj_base_within_map(map, pos, store->sprites[idx])) store->positions[idx] = pos;
+}
 
-    update_object_animation(obj);
+// Entities can't walk through each other: push apart every overlapping pair along the axis
+// of the smallest overlap, half of the overlap for each entity.
+static void resolve_contacts(DynamicObjects *dyn_objs) {
+  EntityStore *store = dyn_objs->store;
+  collision_footprints(store->positions, store->sprites, store->count, dyn_objs->footprints);
+
+  uint32_t pair_count = 0;
+  const ContactPair *pairs =
+      collision_find_pairs(dyn_objs->collisions, dyn_objs->footprints, store->count, &pair_count);
+
+  for (uint32_t k = 0; k < pair_count; k++) {
+    Rect a = dyn_objs->footprints[pairs[k].a];
+    Rect b = dyn_objs->footprints[pairs[k].b];
+    float overlap_x = fminf(a.pos.x + a.w, b.pos.x + b.w) - fmaxf(a.pos.x, b.pos.x);
+    float overlap_y = fminf(a.pos.y + a.h, b.pos.y + b.h) - fmaxf(a.pos.y, b.pos.y);
+
+    Vector shift = {0.0f, 0.0f};
+    if (overlap_x < overlap_y) {
+      shift.x = (a.pos.x < b.pos.x ? -overlap_x : overlap_x) / 2.0f;
+    } else {
+      shift.y = (a.pos.y < b.pos.y ? -overlap_y : overlap_y) / 2.0f;
+    }
+    try_shift(dyn_objs->map, store, pairs[k].a, shift);
+    try_shift(dyn_objs->map, store, pairs[k].b, (Vector){-shift.x, -shift.y});
   }
 }
+
+void dyn_objs_update(DynamicObjects *dyn_objs, Input *input, float delta_time) {
+  if (!dyn_objs || !input) return;
+
+  spatial_hash_build(dyn_objs->grid, dyn_objs->store->positions, dyn_objs->store->count);
+  UpdateContext ctx = {dyn_objs, input, delta_time, entity_store_index(dyn_objs->store, dyn_objs->player)};
+  entity_store_run_parallel(dyn_objs->store, dyn_objs->jobs, UPDATE_GRAIN, think_entities, &ctx);
+  entity_store_run_parallel(dyn_objs->store, dyn_objs->jobs, UPDATE_GRAIN, move_entities, &ctx);
+  animator_tick(dyn_objs->animator, delta_time);
+  entity_store_run_parallel(dyn_objs->store, dyn_objs->jobs, UPDATE_GRAIN, animate_entities, &ctx);
+  resolve_contacts(dyn_objs);
+  entity_store_sync_objects(dyn_objs->store);
+  dyn_objs->ticks++;
+}
@@ -1,19 +1,25 @@
 #ifndef DYN_OBJS_H
 #define DYN_OBJS_H
 
+#include <engine/entity.h>
 #include <engine/input.h>
+#include <engine/jobs.h>
 #include <engine/map.h>
 #include <engine/types.h>
 
 typedef struct DynamicObjects DynamicObjects;
 
-DynamicObjects *create_dynamic_objects(Map *map);
+// Create dynamic objects on the map. Updates are split between workers of 'jobs' (may be NULL).
+DynamicObjects *create_dynamic_objects(Map *map, JobSystem *jobs);
 void free_dyn_objects(DynamicObjects *dyn_objs);
 // Update dynamic objects (movement, animation, etc.).
 // Delta time is logic timestep in seconds.
+// Objects are updated in parallel, result doesn't depend on number of workers.
 void dyn_objs_update(DynamicObjects *dyn_objs, Input *input, float delta_time);
 
+// Render object of the player. The pointer stays valid while the player lives.
 GameObject *dyn_objs_get_player(DynamicObjects *dyn_objs);
-GameObject *dyn_objs_get_objects(DynamicObjects *dyn_objs);
+// Store of all dynamic entities, to be rendered through RenderBatch 'entities'.
+EntityStore *dyn_objs_get_store(DynamicObjects *dyn_objs);
 
 #endif
@@ -6,23 +6,33 @@
 #include <engine/engine.h>
 #include <engine/input.h>
 #include <engine/map.h>
+#include <engine/render_list.h>
 #include <stb_ds.h>
 #include <stdlib.h>
 
 #define MAP_WIDTH 25
 #define MAP_HEIGHT 25
 #define STATIC_OBJ_COUNT 200
+#define MINIMAP_WIDTH 160
+#define MINIMAP_HEIGHT 90
+#define PIP_WIDTH 200
+#define PIP_HEIGHT 150
+#define PIP_ZOOM 0.5f
+#define ZOOM_SPEED 1.02f // zoom change per logic step while key is held
 
 void game_free(Game *game);
 static UIElement hp_bar(Game *game);
 static UIElement fps_ui(Game *game);
 static UIElement coords_ui(Game *game);
+static UIElement minimap_ui(Game *game);
 
-Game *game_create() {
+Game *game_create(const GameConfig *config) {
+  GameConfig defaults = {0};
+  if (!config) config = &defaults;
   Game *game = calloc(1, sizeof(Game));
   if (!game) { return NULL; }
 
-  Engine *engine = engine_create(800, 600, "GTA VI");
+  Engine *engine = config->headless ? engine_create_headless(800, 600) : engine_create(800, 600, "GTA VI");
   game->engine = engine;
   if (!engine) {
     game_free(game);
@@ -43,7 +53,7 @@ Game *game_create() {
   engine_set_map(engine, map);
   game->map = map; // Game creates map, so we have ownership
 
-  DynamicObjects *dyn_objs = create_dynamic_objects(map);
+  DynamicObjects *dyn_objs = create_dynamic_objects(map, engine_get_jobs(engine));
   StaticObjects *st_objs = create_static_objs(map, STATIC_OBJ_COUNT);
   game->st_objs = st_objs;
   game->dyn_objs = dyn_objs;
@@ -57,6 +67,11 @@ Game *game_create() {
   game->player = dyn_objs_get_player(dyn_objs);
   engine_set_player(engine, game->player);
 
+  // Picture-in-picture: zoomed-out view around the player in the bottom-right corner
+  int pip_x = 800 - PIP_WIDTH - 10, pip_y = 600 - PIP_HEIGHT - 10;
+  int pip = engine_add_view(engine, pip_x, pip_y, PIP_WIDTH, PIP_HEIGHT, game->player);
+  if (pip >= 0) engine_set_view_zoom(engine, pip, PIP_ZOOM);
+
   // Load fonts
   if (TTF_Init() != 0) {
     fprintf(stderr, "Failed to initialize TTF: %s\n", TTF_GetError());
@@ -69,25 +84,57 @@ Game *game_create() {
     game_free(game);
     return NULL;
   }
+  game->hud_font = glyph_atlas_create(game->fonts[0]);
+  if (!game->hud_font) {
+    game_free(game);
+    return NULL;
+  }
 
-  // Add UI elements: 0 - HP bar, 1 - FPS counter, 2 - world coordinates.
+  // Add UI elements: 0 - HP bar, 1 - FPS counter, 2 - world coordinates, 3 - minimap.
   game->uis = NULL;
   arrpush(game->uis, hp_bar(game));
   arrpush(game->uis, fps_ui(game));
   arrpush(game->uis, coords_ui(game));
+  arrpush(game->uis, minimap_ui(game));
 
   // Create render batch
   game->batch = (RenderBatch){0};
 
-  // Fill batch with game objects
-  for (int i = 0; i < arrlen(st_objs->objects); i++) { arrpush(game->batch.objs, &st_objs->objects[i]); }
-  GameObject *dyn_objs_arr = dyn_objs_get_objects(dyn_objs);
-  for (int i = 0; i < arrlen(dyn_objs_arr); i++) { arrpush(game->batch.objs, &dyn_objs_arr[i]); }
-  game->batch.obj_count = arrlen(game->batch.objs);
+  // Static objects never move. Flat ones are baked into the map and cost nothing per frame,
+  // upright ones are registered once and stay sorted, so entities can walk behind them.
+  // Entities are rendered straight from their store, so they can be spawned and removed
+  // without touching the batch.
+  game->render_list = render_list_create();
+  if (!game->render_list) {
+    game_free(game);
+    return NULL;
+  }
+  GameObject **flat = NULL;
+  for (int i = 0; i < arrlen(st_objs->objects); i++) {
+    GameObject *obj = &st_objs->objects[i];
+    if (st_objs->flat[i]) {
+      arrpush(flat, obj);
+    } else {
+      render_list_add_static(game->render_list, obj);
+    }
+  }
+  bool baked = map_bake_objects(map, flat, arrlen(flat));
+  arrfree(flat);
+  if (!baked) {
+    game_free(game);
+    return NULL;
+  }
+  game->batch.render_list = game->render_list;
+  game->batch.entities = dyn_objs_get_store(dyn_objs);
 
-  // Fill batch with UI elements
-  for (int i = 0; i < arrlen(game->uis); i++) { arrpush(game->batch.uis, &game->uis[i]); }
-  game->batch.ui_count = arrlen(game->batch.uis);
+  // UI elements rarely change, so they are kept in retained layer instead of batch
+  game->ui_layer = ui_layer_create();
+  if (!game->ui_layer) {
+    game_free(game);
+    return NULL;
+  }
+  for (int i = 0; i < arrlen(game->uis); i++) { ui_layer_add(game->ui_layer, &game->uis[i]); }
+  game->batch.ui_layer = game->ui_layer;
 
   return game;
 }
@@ -99,13 +146,21 @@ void game_free(Game *game) {
   if (game->st_objs) free_static_objs(game->st_objs);
   if (game->uis) {
     for (int i = 0; i < arrlen(game->uis); i++) {
-      free_sprite(game->uis[i].sprite);
-      free(game->uis[i].sprite);
+      // Text label sprites are owned by labels
+      Sprite *sprite = game->uis[i].sprite;
+      if (sprite == &game->fps_label.sprite || sprite == &game->coords_label.sprite) continue;
+      free_sprite(sprite);
+      free(sprite);
     }
     arrfree(game->uis);
   }
+  text_label_free(&game->fps_label);
+  text_label_free(&game->coords_label);
+  glyph_atlas_free(game->hud_font);
   if (game->batch.objs) arrfree(game->batch.objs);
   if (game->batch.uis) arrfree(game->batch.uis);
+  if (game->ui_layer) ui_layer_free(game->ui_layer);
+  render_list_free(game->render_list);
   if (game->engine) engine_free(game->engine);
   if (game->fonts) {
     for (int i = 0; i < arrlen(game->fonts); i++) { TTF_CloseFont(game->fonts[i]); }
@@ -119,7 +174,13 @@ void game_free(Game *game) {
 void game_update(Game *game, Input *input) {
   if (!game || !input) return;
 
-  dyn_objs_update(game->dyn_objs, input, ENGINE_LOGIC_STEP);
+  dyn_objs_update(game->dyn_objs, input, engine_get_tick_step(game->engine));
+
+  // Zoom: Z - in, X - out, C - reset
+  float zoom = engine_get_zoom(game->engine);
+  if (input->z) engine_set_zoom(game->engine, zoom * ZOOM_SPEED);
+  if (input->x) engine_set_zoom(game->engine, zoom / ZOOM_SPEED);
+  if (input->c) engine_set_zoom(game->engine, 1.0f);
 }
 
 static UIElement hp_bar(Game *game) {
@@ -139,9 +200,8 @@ static UIElement fps_ui(Game *game) {
   ui.mode = UI_POS_SCREEN;
   ui.position.screen = (Vector){10.0f, 10.0f};
   ui.z_index = 2;
-  Sprite *sprite = malloc(sizeof(Sprite));
-  *sprite = text_sprite("FPS: not initialized", game->fonts[0], (SDL_Color){255, 255, 255, 255});
-  ui.sprite = sprite;
+  text_label_set(&game->fps_label, game->hud_font, "FPS: not initialized", 0xFFFFFFFF);
+  ui.sprite = &game->fps_label.sprite;
   return ui;
 }
 
@@ -150,8 +210,23 @@ static UIElement coords_ui(Game *game) {
   ui.mode = UI_POS_SCREEN;
   ui.position.screen = (Vector){10.0f, 30.0f};
   ui.z_index = 2;
+  text_label_set(&game->coords_label, game->hud_font, "Coords: not initialized", 0xFFFFFFFF);
+  ui.sprite = &game->coords_label.sprite;
+  return ui;
+}
+
+// Overview of the whole map in the top-right corner. Drawn once, the UI layer caches it.
+static UIElement minimap_ui(Game *game) {
+  UIElement ui = {0};
+  ui.mode = UI_POS_SCREEN;
+  ui.position.screen = (Vector){800.0f - MINIMAP_WIDTH - 10.0f, 10.0f};
+  ui.z_index = 1;
   Sprite *sprite = malloc(sizeof(Sprite));
-  *sprite = text_sprite("Coords: not initialized", game->fonts[0], (SDL_Color){255, 255, 255, 255});
+  sprite->width = MINIMAP_WIDTH;
+  sprite->height = MINIMAP_HEIGHT;
+  sprite->pixels = malloc(MINIMAP_WIDTH * MINIMAP_HEIGHT * sizeof(uint32_t));
+  for (int i = 0; i < MINIMAP_WIDTH * MINIMAP_HEIGHT; i++) { sprite->pixels[i] = 0x80000000; }
+  map_render_overview(game->map, sprite->pixels, MINIMAP_WIDTH, MINIMAP_HEIGHT);
   ui.sprite = sprite;
   return ui;
 }
@@ -4,21 +4,34 @@
 #include "dyn_objs.h"
 #include "static_objs.h"
 #include <engine/engine.h>
+#include <engine/render_list.h>
+#include <engine/text.h>
 #include <engine/types.h>
+#include <engine/ui.h>
 
 typedef struct Game {
   DynamicObjects *dyn_objs;
   StaticObjects *st_objs;
   UIElement *uis;
-  RenderBatch batch; // All objects and UI elements to render
+  UILayer *ui_layer;       // Sorted UI elements with cached composition of static ones
+  RenderList *render_list; // Static objects, registered once
+  RenderBatch batch;       // All objects and UI elements to render
   GameObject *player;
   TTF_Font **fonts;
+  GlyphAtlas *hud_font; // glyphs of fonts[0] for text updated every frame
+  TextLabel fps_label;
+  TextLabel coords_label;
 
   Map *map;
   Engine *engine;
 } Game;
 
-Game *game_create();
+typedef struct GameConfig {
+  bool headless; // no window: replays and benchmarks
+} GameConfig;
+
+// Create game world. 'config' may be NULL for defaults.
+Game *game_create(const GameConfig *config);
 void game_free(Game *game);
 void game_update(Game *game, Input *input);
 
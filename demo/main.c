@@ -5,39 +5,118 @@
 #include <engine/engine.h>
 #include <engine/input.h>
 #include <engine/map.h>
+#include <engine/random.h>
+#include <engine/replay.h>
 #include <math.h>
 #include <stb_ds.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 static void update(Input *input, void *user_data);
 
-int main(void) {
+static void usage(const char *prog) {
+  fprintf(stderr,
+      "Usage: %s [--seed N] [--record FILE | --replay FILE] [--memory SEC]\n"
+      "  --seed N       seed of world generation (default: current time)\n"
+      "  --record FILE  record input of the session into FILE\n"
+      "  --replay FILE  replay recorded session without window at maximum speed\n"
+      "  --memory SEC   print memory usage by category every SEC seconds\n",
+      prog);
+}
+
+int main(int argc, char **argv) {
+  const char *record_path = NULL;
+  const char *replay_path = NULL;
+  uint64_t seed = (uint64_t)time(NULL);
+  float memory_period = 0.0f;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = strtoull(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+      record_path = argv[++i];
+    } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+      replay_path = argv[++i];
+    } else if (strcmp(argv[i], "--memory") == 0 && i + 1 < argc) {
+      memory_period = strtof(argv[++i], NULL);
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  // World generation must use the recorded seed to reproduce the session
+  Replay *replay = NULL;
+  if (replay_path) {
+    replay = replay_load(replay_path);
+    if (!replay) {
+      fprintf(stderr, "Failed to load replay %s\n", replay_path);
+      return 1;
+    }
+    seed = replay_seed(replay);
+  }
+  rand_seed(seed);
 
-  Game *game = game_create();
+  GameConfig config = {0};
+  config.headless = replay != NULL;
+  Game *game = game_create(&config);
   if (!game) {
     fprintf(stderr, "Failed to create game\n");
+    replay_free(replay);
     return 1;
   }
   Engine *engine = game->engine;
+  if (replay) engine_play_replay(engine, replay);
+  if (record_path) engine_start_recording(engine, seed);
+  if (memory_period > 0.0f) engine_set_memory_dump(engine, stderr, (uint32_t)(memory_period * 1000.0f));
+  uint64_t start = SDL_GetTicks64();
+  uint32_t frames = 0;
+
+  // Text shown on labels. Labels are recomposed only when it changes.
+  char fps[100] = "";
+  char coords[100] = "";
   while (engine_begin_frame(engine, update, game)) {
-    char fps[100];
-    char coords[100];
+    char prev_fps[100];
+    char prev_coords[100];
+    memcpy(prev_fps, fps, sizeof(fps));
+    memcpy(prev_coords, coords, sizeof(coords));
     snprintf(fps, sizeof(fps), "FPS: %d", (int)engine_get_fps(engine));
     snprintf(coords,
         sizeof(coords),
         "Coords: (%d, %d)",
         (int)game->player->position.x,
         (int)game->player->position.y);
-    free_sprite(game->uis[1].sprite);
-    free_sprite(game->uis[2].sprite);
-    *game->uis[1].sprite = text_sprite(fps, game->fonts[0], (SDL_Color){255, 255, 255, 255});
-    *game->uis[2].sprite = text_sprite(coords, game->fonts[0], (SDL_Color){255, 255, 255, 255});
+    if (strcmp(fps, prev_fps) != 0) {
+      text_label_set(&game->fps_label, game->hud_font, fps, 0xFFFFFFFF);
+      ui_layer_invalidate(game->ui_layer, &game->uis[1]);
+    }
+    if (strcmp(coords, prev_coords) != 0) {
+      text_label_set(&game->coords_label, game->hud_font, coords, 0xFFFFFFFF);
+      ui_layer_invalidate(game->ui_layer, &game->uis[2]);
+    }
 
     engine_render(engine, &game->batch);
     engine_end_frame(engine);
+    frames++;
+  }
+
+  if (record_path && !engine_save_recording(engine, record_path)) {
+    fprintf(stderr, "Failed to save recording %s\n", record_path);
+  }
+  if (replay) {
+    // Final player position identifies the run: same replay must always end at the same place
+    uint64_t elapsed = SDL_GetTicks64() - start;
+    printf("Replayed %u ticks in %llu ms (%.1f FPS), player at (%.2f, %.2f)\n",
+        replay_tick_count(replay),
+        (unsigned long long)elapsed,
+        elapsed ? frames * 1000.0 / elapsed : 0.0,
+        game->player->position.x,
+        game->player->position.y);
   }
 
   game_free(game);
+  replay_free(replay);
   return 0;
 }
 
@@ -11,6 +11,10 @@
 
 typedef enum { OBJ_BUSH1 = 0, OBJ_BUSH2, OBJ_BUSH3, OBJ_TREE, OBJ_CACTUS, OBJ_PALM, OBJ_COUNT } ObjectType;
 
+// Types lying flat on the ground, that may be baked into the map. All current props stand upright:
+// entities north of them must be drawn behind them.
+static const bool type_flat[OBJ_COUNT] = {false};
+
 static Sprite *load_st_sprites() {
   Sprite *obj_sprites = calloc(OBJ_COUNT, sizeof(Sprite));
 
@@ -23,28 +27,52 @@ static Sprite *load_st_sprites() {
   return obj_sprites;
 }
 
-static GameObject *gen_st_objs(Map *map, Sprite *sprites, int count) {
-  if (!map || !sprites) return NULL;
-
-  GameObject *objects = NULL;
+static GameObject *gen_st_objs(Map *map, Sprite *sprites, int count, bool **flat) {
+  if (!map || !sprites || count <= 0) return NULL;
 
-  while (arrlen(objects) < count) {
-    // Random object type (determine first to know sprite size)
+  // Object types are chosen first, so positions can be generated in bulk for each type (margin depends on
+  // sprite size).
+  ObjectType *types = malloc(count * sizeof(ObjectType));
+  if (!types) return NULL;
+  int type_counts[OBJ_COUNT] = {0};
+  for (int i = 0; i < count;) {
     ObjectType type = rand_big() % OBJ_COUNT;
-    Sprite *sprite = &sprites[type];
+    if (!sprites[type].pixels) continue;
+    types[i++] = type;
+    type_counts[type]++;
+  }
 
-    if (!sprite->pixels) continue;
+  VectorU32 *positions[OBJ_COUNT] = {0};
+  for (int t = 0; t < OBJ_COUNT; t++) {
+    if (type_counts[t] == 0) continue;
+    positions[t] = malloc(type_counts[t] * sizeof(VectorU32));
+    if (!positions[t]) {
+      for (int j = 0; j < t; j++) { free(positions[j]); }
+      free(types);
+      return NULL;
+    }
+    int margin = hypotenuse((float)sprites[t].width, (float)sprites[t].height);
+    map_gen_random_positions(map, margin, positions[t], type_counts[t]);
+  }
 
-    int margin = hypotenuse((float)sprite->width, (float)sprite->height);
-    VectorU32 world = map_gen_random_position(map, margin);
+  GameObject *objects = NULL;
+  arrsetcap(objects, count);
+  int used[OBJ_COUNT] = {0};
+  for (int i = 0; i < count; i++) {
+    ObjectType type = types[i];
+    Sprite *sprite = &sprites[type];
+    VectorU32 world = positions[type][used[type]++];
 
     GameObject obj = {0};
     obj.position = (Vector){(float)world.x, (float)world.y - sprite->height / 2};
     obj.cur_sprite = sprite;
     obj.data = NULL;
     arrpush(objects, obj);
+    arrpush(*flat, type_flat[type]);
   }
 
+  for (int t = 0; t < OBJ_COUNT; t++) { free(positions[t]); }
+  free(types);
   return objects;
 }
 
@@ -60,7 +88,7 @@ StaticObjects *create_static_objs(Map *map, int count) {
     return NULL;
   }
 
-  st_objs->objects = gen_st_objs(map, st_objs->sprites, count);
+  st_objs->objects = gen_st_objs(map, st_objs->sprites, count, &st_objs->flat);
 
   return st_objs;
 }
@@ -74,6 +102,7 @@ void free_static_objs(StaticObjects *st_objs) {
   }
 
   if (st_objs->objects) { arrfree(st_objs->objects); }
+  arrfree(st_objs->flat);
 
   free(st_objs);
 }
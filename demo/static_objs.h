@@ -3,10 +3,14 @@
 
 #include <engine/map.h>
 #include <engine/types.h>
+#include <stdbool.h>
 
 typedef struct StaticObjects {
   Sprite *sprites;
   GameObject *objects;
+  // flat[i] - objects[i] lies on the ground (decal, flat prop), nothing is ever hidden behind it,
+  // so it may be baked into the map
+  bool *flat;
 } StaticObjects;
 
 StaticObjects *create_static_objs(Map *map, int count);
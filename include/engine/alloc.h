@@ -0,0 +1,38 @@
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Allocator for memory with known lifetime (frame scratch), so hot paths don't go through malloc/free.
+// Returns memory aligned to ALLOC_ALIGN bytes and is not thread-safe. Long-lived records
+// (entities, components) are kept in ObjectPool, see engine/object_pool.h.
+#define ALLOC_ALIGN 16
+
+// Linear (bump) allocator. Allocation moves a pointer, everything is released at once by arena_reset.
+//
+// If the buffer is exhausted, allocations continue in overflow blocks from malloc, so they never fail
+// while memory is available. On reset, overflow blocks are released and the buffer grows to the peak
+// usage, so a steady workload stops overflowing after one frame.
+typedef struct Arena Arena;
+
+typedef struct {
+  size_t capacity;        // size of the main buffer
+  size_t used;            // bytes allocated since last reset, including alignment padding
+  size_t peak;            // highest 'used' ever seen
+  uint64_t allocations;   // allocations since last reset
+  uint64_t overflows;     // allocations served from overflow blocks since creation
+  uint64_t resets;
+} ArenaStats;
+
+Arena *arena_create(size_t capacity);
+void arena_free(Arena *arena);
+// Returns NULL only if 'size' is 0 or memory is exhausted. Memory is not initialized.
+void *arena_alloc(Arena *arena, size_t size);
+// Same as arena_alloc, but memory is zeroed
+void *arena_calloc(Arena *arena, size_t count, size_t size);
+// Release all allocations. Pointers returned before become invalid.
+void arena_reset(Arena *arena);
+ArenaStats arena_stats(const Arena *arena);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <engine/types.h>
+#include <stdint.h>
+
+// Table-driven sprite animations.
+//
+// AnimSet describes animations of one kind of entities: frames, clips and a state table that maps
+// (state, variant) to a clip, e.g. (walk, left) -> clip 5. Animator owns registered sets and a clock.
+// All animated entities are advanced in one pass. Entities wait for absolute time of their next frame,
+// so the pass only reads their state until a frame actually changes.
+
+// Sequence of frames in AnimSet.frames
+typedef struct {
+  uint16_t start;    // Index of the first frame
+  uint16_t count;    // Number of frames
+  uint32_t frame_ms; // Duration of one frame in milliseconds. 0 means the clip doesn't advance.
+  uint16_t next;     // Clip played after this one ends. Index of the clip itself means looping.
+} AnimClip;
+
+typedef struct {
+  Sprite *frames; // All frames of the set, owned by user
+  const AnimClip *clips;
+  uint16_t clip_count;
+
+  // Clip index for every (state, variant): state_clips[state * variant_count + variant]
+  const uint16_t *state_clips;
+  uint16_t state_count;
+  uint16_t variant_count;
+} AnimSet;
+
+// Animation state of an entity
+typedef struct {
+  uint16_t set;           // Index of AnimSet in Animator
+  uint16_t clip;          // Current clip in the set
+  uint16_t frame;         // Frame number inside the clip
+  uint16_t state;         // Last state set by animator_set_state
+  uint32_t next_frame_ms; // Animator clock time of the next frame change
+} EntityAnim;
+
+typedef struct Animator Animator;
+
+Animator *animator_create(void);
+void animator_free(Animator *an);
+
+// Index of a set that is never valid, returned when a set can't be registered
+#define ANIM_SET_NONE UINT16_MAX
+// Most sets an animator can hold, so every index fits uint16_t and differs from ANIM_SET_NONE
+#define ANIM_MAX_SETS UINT16_MAX
+
+// Register animation set. Set tables are not copied, they must live as long as the animator.
+// Returns index of the set to use in EntityAnim.set, or ANIM_SET_NONE if there are ANIM_MAX_SETS
+// sets already or memory is exhausted.
+uint16_t animator_add_set(Animator *an, AnimSet set);
+
+// Functions below change only given entity, so they can be called for different entities in parallel.
+
+// Start playing animation set from its first clip. Writes first frame to 'sprite'.
+void animator_start(const Animator *an, EntityAnim *anim, Sprite **sprite, uint16_t set);
+// Switch to given clip from its first frame. Does nothing if the clip is already playing.
+void animator_play(const Animator *an, EntityAnim *anim, Sprite **sprite, uint16_t clip);
+// Switch to the clip of given (state, variant) using state table of the entity set.
+void animator_set_state(
+    const Animator *an, EntityAnim *anim, Sprite **sprite, uint16_t state, uint16_t variant);
+
+// Advance animator clock. Call it once per logic step before animator_advance.
+void animator_tick(Animator *an, float delta_time);
+// Advance frames of 'count' entities and update their sprites.
+// Reads only animator, so different ranges of entities can be advanced in parallel.
+void animator_advance(const Animator *an, EntityAnim *anims, Sprite **sprites, uint32_t count);
+
+#endif
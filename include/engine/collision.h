@@ -0,0 +1,36 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <engine/types.h>
+#include <stdint.h>
+
+// Broadphase collision detection between objects footprints (sweep and prune).
+//
+// Objects are kept sorted by left edge of their footprints between calls. Objects move a little
+// every tick, so re-sorting is almost linear and only neighbours along X axis are checked.
+
+// Pair of indices of overlapping rects, a < b
+typedef struct {
+  uint32_t a, b;
+} ContactPair;
+
+typedef struct CollisionWorld CollisionWorld;
+
+// 'capacity' is initial number of objects, it grows if needed.
+CollisionWorld *collision_create(uint32_t capacity);
+void collision_free(CollisionWorld *cw);
+
+// Footprint of object: part of the sprite bottom where the object stands on the ground.
+Rect object_footprint(Vector position, const Sprite *sprite);
+// Compute footprints for arrays of positions and sprites. Objects without sprite get empty footprints.
+void collision_footprints(const Vector *positions, Sprite *const *sprites, uint32_t count, Rect *out);
+
+// Find all pairs of overlapping rects.
+//
+// Indices in pairs refer to 'rects' array. Keep the same order of objects between calls to get
+// benefit from sorting made on previous call.
+// Returns array of 'pair_count' pairs owned by 'cw', valid until next call.
+const ContactPair *
+collision_find_pairs(CollisionWorld *cw, const Rect *rects, uint32_t count, uint32_t *pair_count);
+
+#endif
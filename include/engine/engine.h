@@ -1,18 +1,26 @@
 #ifndef ENGINE_H
 #define ENGINE_H
 
+#include <engine/alloc.h>
 #include <engine/input.h>
+#include <engine/jobs.h>
 #include <engine/map.h>
+#include <engine/memory.h>
+#include <engine/replay.h>
+#include <engine/timestep.h>
 #include <engine/types.h>
 #include <stdbool.h>
 
-// Fixed timestep for game logic updates (60 updates per second).
-// Game logic speed is independent of FPS.
-#define ENGINE_LOGIC_STEP (1.0f / 60.0f)
+// Default rate of game logic updates (60 updates per second).
+// Game logic speed is independent of FPS. Can be changed at runtime with 'engine_set_tick_rate'.
+#define ENGINE_DEFAULT_TICK_RATE 60.0f
 
 typedef struct Engine Engine;
 
 Engine *engine_create(int width, int height, const char *title);
+// Create engine without window and input devices (replays, benchmarks, tests).
+// It runs exactly one logic step per frame without waiting, and engine_end_frame presents nothing.
+Engine *engine_create_headless(int width, int height);
 void engine_set_player(Engine *e, GameObject *player);
 void engine_set_map(Engine *e, Map *map);
 void engine_free(Engine *e);
@@ -27,10 +35,81 @@ bool engine_begin_frame(Engine *e, void (*update)(Input *input, void *user_data)
 void engine_render(Engine *e, RenderBatch *batch);
 // End frame: present rendered frame on screen and update FPS.
 void engine_end_frame(Engine *e);
+// Last rendered frame: width x height ARGB pixels, row by row (screenshots, headless tests).
+const uint32_t *engine_get_pixels(Engine *e);
 
 // Get current FPS. Calculation based on the EMA (Exponential Moving Average) formula.
 float engine_get_fps(Engine *e);
 // Time between last two displayed frames in milliseconds.
 uint64_t engine_get_delta_time(Engine *e);
 
+// Camera zoom limits
+#define ENGINE_MIN_ZOOM 0.125f
+#define ENGINE_MAX_ZOOM 8.0f
+
+// Set zoom of the main view: screen pixels per world pixel, clamped to [ENGINE_MIN_ZOOM, ENGINE_MAX_ZOOM].
+// Zoom 1 draws sprites as loaded, integer zoom replicates pixels, other values are resampled.
+// Screen-space UI is not zoomed.
+void engine_set_zoom(Engine *e, float zoom);
+float engine_get_zoom(Engine *e);
+
+// Views: several cameras, each drawn into its own rectangle of the screen (split-screen,
+// picture-in-picture). View 0 is the main one and always exists: by default it covers the whole
+// screen and follows the player. Views are drawn in index order, so later ones are on top.
+// Objects are sorted and bounded once per frame for all views, and views are rasterized in parallel.
+// UI is drawn once over the whole screen; attached elements follow the main view.
+#define ENGINE_MAX_VIEWS 8
+
+// Add view with viewport (x, y, width, height) in screen pixels, following 'target' (may be NULL).
+// Returns view index or -1 if there is no free slot or allocation failed.
+int engine_add_view(Engine *e, int x, int y, int width, int height, GameObject *target);
+// Remove view. Main view (0) can't be removed.
+void engine_remove_view(Engine *e, int view);
+// Move or resize viewport. Returns false on invalid arguments or allocation failure.
+bool engine_set_view_rect(Engine *e, int view, int x, int y, int width, int height);
+void engine_set_view_target(Engine *e, int view, GameObject *target);
+// Move camera of the view straight to its target instead of following it smoothly (scene cuts, teleports)
+void engine_snap_view(Engine *e, int view);
+// Same as engine_set_zoom, for given view
+void engine_set_view_zoom(Engine *e, int view, float zoom);
+
+// Logic timestep settings. See 'TickClock' for details.
+// Returns false if 'tick_rate' is not positive.
+bool engine_set_tick_rate(Engine *e, float tick_rate);
+// Length of one logic step in seconds. Pass it as delta time to game logic.
+float engine_get_tick_step(Engine *e);
+// Most logic steps run in one frame (at least 1).
+void engine_set_max_ticks_per_frame(Engine *e, uint32_t max_ticks);
+void engine_set_overrun_policy(Engine *e, TickOverrunPolicy policy);
+// Counters of run, late and skipped logic steps since engine creation.
+TickStats engine_get_tick_stats(Engine *e);
+
+// Recording and replay of logic input (see engine/replay.h).
+//
+// Start recording input of every logic step. 'seed' is stored in the recording: the caller must seed
+// the global generator with it (rand_seed) before creating the world. Previous recording is dropped.
+bool engine_start_recording(Engine *e, uint64_t seed);
+// Save what is recorded so far. Returns false if nothing is being recorded or on I/O error.
+bool engine_save_recording(Engine *e, const char *path);
+// Feed logic steps with input from 'replay' instead of the user and switch to its tick rate.
+// engine_begin_frame returns false once all recorded steps are run. Replay is not owned by the engine
+// and must outlive it or be detached with NULL. Returns false if the replay has invalid tick rate.
+bool engine_play_replay(Engine *e, Replay *replay);
+
+// Print memory usage by category (see engine/memory.h) into 'out' at the end of a frame,
+// at most once per 'interval_ms' milliseconds. NULL 'out' disables the report.
+void engine_set_memory_dump(Engine *e, FILE *out, uint32_t interval_ms);
+
+// Worker pool owned by the engine (one participant per CPU core).
+// Use it in 'update' to run per-entity logic in parallel.
+JobSystem *engine_get_jobs(Engine *e);
+
+// Initial size of the frame arena. It grows to the peak frame usage, so this only avoids early regrowth.
+#define ENGINE_FRAME_ARENA_SIZE (1024 * 1024)
+
+// Arena for memory that lives until the end of the current frame (temporary lists, per-frame text,
+// render data). It is reset at the beginning of every frame, so allocations are never freed one by one.
+// Don't use it from worker jobs: arena is not thread-safe.
+Arena *engine_get_frame_arena(Engine *e);
+
 #endif
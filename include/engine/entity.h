@@ -0,0 +1,93 @@
+#ifndef ENTITY_H
+#define ENTITY_H
+
+#include <engine/animation.h>
+#include <engine/jobs.h>
+#include <engine/types.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Returned by entity_store_index for stale handles
+#define ENTITY_NONE UINT32_MAX
+
+// Entity storage as structure of arrays.
+//
+// Every component is a separate contiguous array indexed by entity index, so update loops
+// touch only components they need. Entities are always packed in [0, count): removing one moves
+// the last entity into its place, so indices are valid only until the next removal.
+// To keep a reference to an entity, use its Handle: it survives removals of other entities and is
+// detected as stale once the entity itself is removed. Add and remove are O(1).
+//
+// Arrays are allocated once for 'capacity' entities and never reallocated.
+typedef struct EntityStore {
+  uint32_t count;
+  uint32_t capacity;
+  struct SlotTable *table; // handle <-> index mapping
+
+  Vector *positions;  // Top-left corner in world coordinates
+  Vector *velocities; // Position change per logic step
+  Sprite **sprites;   // Current sprite to render
+  EntityAnim *anims;  // Animation state, advanced by Animator
+
+  // Custom user component: 'capacity' records of 'user_size' bytes each.
+  void *user;
+  size_t user_size;
+
+  // Render view of entities. Positions and sprites are copied here by entity_store_sync_objects.
+  // Objects are indexed by handle slot, not by entity index, so pointers to them stay valid
+  // while their entities live (see entity_store_object): UI elements and cameras may follow them.
+  // Put the store into RenderBatch 'entities' to render all live entities.
+  // Objects are interpolated between the last two syncs.
+  GameObject *objects;
+} EntityStore;
+
+// Create store for up to 'capacity' entities with user component of 'user_size' bytes (may be 0).
+EntityStore *entity_store_create(uint32_t capacity, size_t user_size);
+void entity_store_free(EntityStore *store);
+
+// Add entity with given position and sprite. Other components are zeroed.
+// New entity gets index 'count - 1'. Returns its handle or HANDLE_NONE if the store is full.
+Handle entity_store_add(EntityStore *store, Vector position, Sprite *sprite);
+// Remove entity. The last entity is moved into its place to keep arrays packed.
+// Returns false if the handle is stale.
+bool entity_store_remove(EntityStore *store, Handle entity);
+
+// Current index of entity or ENTITY_NONE if the handle is stale.
+uint32_t entity_store_index(const EntityStore *store, Handle entity);
+// Handle of entity at given index, HANDLE_NONE if index is out of range.
+Handle entity_store_handle(const EntityStore *store, uint32_t index);
+// Render view object of entity or NULL if the handle is stale. The pointer is stable while
+// the entity lives.
+GameObject *entity_store_object(const EntityStore *store, Handle entity);
+// Render view object of entity at given index
+GameObject *entity_store_object_at(const EntityStore *store, uint32_t index);
+
+// Pointer to user component of entity with given index.
+static inline void *entity_store_user(EntityStore *store, uint32_t index) {
+  return (char *)store->user + (size_t)index * store->user_size;
+}
+
+// System processes entities with indices in [begin, end).
+// 'worker' is index of the thread running it (see JobRangeFunc), 0 for entity_store_run.
+typedef void (*EntitySystem)(EntityStore *store,
+    uint32_t begin,
+    uint32_t end,
+    uint32_t worker,
+    void *user_data);
+// Run system over all entities.
+void entity_store_run(EntityStore *store, EntitySystem system, void *user_data);
+// Run system over all entities in parallel, in ranges of 'grain' entities.
+//
+// System must write only components of entities in its range. Reading other entities is safe only
+// for components that are not written by the same system.
+void entity_store_run_parallel(EntityStore *store,
+    JobSystem *jobs,
+    uint32_t grain,
+    EntitySystem system,
+    void *user_data);
+
+// Copy positions and sprites into render view objects of live entities.
+// Call it once per logic step: previous synced positions become objects 'prev_position'.
+void entity_store_sync_objects(EntityStore *store);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <stdint.h>
+
+// Worker thread pool for data-parallel loops.
+//
+// Range is split into chunks of 'grain' items. Every participant (workers and the calling thread)
+// gets an equal share of chunks and steals chunks from others when its own share is done,
+// so uneven work is balanced automatically.
+typedef struct JobSystem JobSystem;
+
+// Processes items [begin, end). 'worker' is index of participant in [0, jobs_worker_count),
+// it can be used to index per-worker data. Calling thread is always worker 0.
+typedef void (*JobRangeFunc)(uint32_t begin, uint32_t end, uint32_t worker, void *user_data);
+
+// Create pool with given number of participants including the calling thread.
+// 0 means number of CPU cores. 1 means no background threads (everything runs on calling thread).
+JobSystem *jobs_create(int worker_count);
+void jobs_free(JobSystem *js);
+
+// Number of participants including the calling thread. Returns 1 if 'js' is NULL.
+uint32_t jobs_worker_count(JobSystem *js);
+
+// Run 'fn' over [0, count) in chunks of 'grain' items and wait until all chunks are done.
+// Must be called from one thread at a time, not from inside another parallel_for.
+// If 'js' is NULL, the whole range runs on the calling thread.
+void jobs_parallel_for(JobSystem *js, uint32_t count, uint32_t grain, JobRangeFunc fn, void *user_data);
+
+#endif
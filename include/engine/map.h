@@ -26,9 +26,35 @@ void map_free(Map *map);
 bool is_point_within_map(Map *map, Vector pos, uint32_t margin);
 
 // Generate a random position within the map boundaries, considering a margin.
+//
+// Positions are uniformly distributed over the map area. If the margin is too big
+// to leave any area, the map center is returned.
 VectorU32 map_gen_random_position(Map *map, uint32_t margin);
+// Generate 'count' random positions within the map boundaries into 'out'.
+//
+// Same as calling map_gen_random_position 'count' times, but the map corners are computed once.
+void map_gen_random_positions(Map *map, uint32_t margin, VectorU32 *out, uint32_t count);
 
 // Returns map size in pixels.
 VectorU32 map_get_size(Map *map);
 
+// Draw objects with their shadows into the prerendered map, in depth order, and rebuild mip levels.
+//
+// Baked objects cost nothing per frame, but they are always behind everything rendered over the map,
+// so bake only flat ones (decals, low props) that nothing should be hidden behind. Objects keep
+// their own sprites and are not referenced after the call. Returns false on allocation failure.
+bool map_bake_objects(Map *map, GameObject **objs, uint32_t count);
+
+// Number of mip levels of the prerendered map, including full resolution level.
+//
+// map_create builds the chain with 2x2 box filter: every level is half the size of the previous one,
+// down to 1x1. Zoomed-out views and overviews are sampled from them, so their cost depends on output
+// size, not on map size.
+uint32_t map_mip_count(const Map *map);
+
+// Draw the whole map scaled to fit into 'dst' (ARGB buffer of dst_width x dst_height), e.g. a minimap.
+// Map keeps aspect ratio and is centered; it is blended over existing content of 'dst'.
+// Returns scale (dst pixels per map pixel) to place markers on it, 0 on error.
+float map_render_overview(const Map *map, uint32_t *dst, uint32_t dst_width, uint32_t dst_height);
+
 #endif
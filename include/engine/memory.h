@@ -0,0 +1,57 @@
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Accounting of memory allocated by the engine, by category.
+//
+// Engine subsystems allocate their buffers through memory_alloc/memory_calloc/memory_realloc and release
+// them with memory_free, which records every buffer with its size. Memory allocated by the caller is not
+// counted unless it is registered with memory_track (e.g. when its ownership is passed to the engine).
+// memory_free and memory_untrack ignore pointers that are not tracked, so functions like free_sprite
+// work for buffers from malloc too. All functions are thread-safe.
+typedef enum {
+  MEMORY_MAP,      // prerendered map, its mip levels and tile indices
+  MEMORY_SPRITES,  // pixels of sprites loaded from files
+  MEMORY_TEXT,     // glyph atlases, text labels and text sprites
+  MEMORY_UI,       // retained UI layer: sorted elements and cached overlays
+  MEMORY_ENTITIES, // entity stores, object pools and render lists
+  MEMORY_RENDER,   // framebuffers of the screen and views, arenas (frame scratch)
+  MEMORY_CATEGORY_COUNT
+} MemoryCategory;
+
+typedef struct {
+  size_t current;       // bytes in live buffers
+  size_t peak;          // highest 'current' ever seen
+  uint32_t blocks;      // live buffers
+  uint64_t allocations; // buffers tracked since start, reallocations included
+} MemoryUsage;
+
+typedef struct {
+  MemoryUsage categories[MEMORY_CATEGORY_COUNT];
+  size_t current; // sum over categories
+  size_t peak;    // highest 'current' ever seen, not the sum of category peaks
+} MemoryStats;
+
+// Same as malloc/calloc/realloc, and the buffer is counted in 'category'.
+void *memory_alloc(MemoryCategory category, size_t size);
+void *memory_calloc(MemoryCategory category, size_t count, size_t size);
+void *memory_realloc(MemoryCategory category, void *ptr, size_t size);
+// Same as free. Tracked buffers stop being counted.
+void memory_free(void *ptr);
+
+// Count buffer allocated elsewhere, e.g. adopted by the engine. Tracking the same pointer again
+// replaces its category and size.
+void memory_track(MemoryCategory category, const void *ptr, size_t size);
+// Stop counting buffer without freeing it.
+void memory_untrack(const void *ptr);
+
+MemoryStats memory_get_stats(void);
+MemoryUsage memory_get_usage(MemoryCategory category);
+const char *memory_category_name(MemoryCategory category);
+// Print current and peak usage of every category and the total, one line each.
+void memory_dump(FILE *out);
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef NOISE_H
+#define NOISE_H
+
+#include <engine/map.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Coherent noise for procedural generation, built on the same lattice hash as rand01.
+//
+// All functions return values in range [0, 1]. Noise is evaluated by whole rows,
+// so filling big arrays is much faster than sampling point by point.
+
+typedef enum {
+  NOISE_VALUE,    // Interpolated random values in lattice points
+  NOISE_GRADIENT, // Perlin-like gradient noise
+  NOISE_SIMPLEX,  // Simplex noise, less axis-aligned artifacts
+} NoiseType;
+
+typedef struct {
+  NoiseType type;
+  uint32_t seed;
+  float frequency;  // Lattice cells per unit of input coordinates
+  int octaves;      // Number of fractal layers (1 = plain noise)
+  float lacunarity; // Frequency multiplier per octave
+  float gain;       // Amplitude multiplier per octave
+} NoiseParams;
+
+// Default parameters: 4 octaves, frequency 1/16, lacunarity 2, gain 0.5.
+NoiseParams noise_default_params(NoiseType type, uint32_t seed);
+
+// Sample noise in a single point.
+float noise_sample(const NoiseParams *params, float x, float y);
+
+// Sample 'count' points of a row: (x0 + i * step, y) for i in [0, count).
+void noise_fill_row(const NoiseParams *params, float x0, float y, float step, float *out, uint32_t count);
+
+// Fill 2D array (width * height, row-major) with noise sampled in integer points.
+void noise_fill(const NoiseParams *params, float *out, uint32_t width, uint32_t height);
+
+// Fill tiles of the map with sprite indices chosen by noise value.
+//
+// 'thresholds' is an ascending array of (sprite_count - 1) values: noise below thresholds[0] gives
+// sprite 0, between thresholds[0] and thresholds[1] gives sprite 1 and so on.
+// If NULL, noise range is split into equal parts.
+// If ti->tiles is NULL, it is allocated (width * height elements).
+// Returns false on allocation failure or invalid tiles info.
+bool noise_fill_tiles(const NoiseParams *params,
+    TilesInfo *ti,
+    uint32_t width,
+    uint32_t height,
+    const float *thresholds);
+
+#endif
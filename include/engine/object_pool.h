@@ -0,0 +1,41 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <engine/types.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Pool of same-sized records (per-entity data, projectiles, particles) referenced by handles.
+//
+// Items are packed in one contiguous array, so iterating over all of them is a linear scan.
+// Removing an item moves the last one into its place; handles stay valid, pointers don't.
+// Alloc, free and lookup are O(1). Storage grows by doubling, so a pool sized for the peak count
+// never calls malloc while spawning and despawning.
+typedef struct ObjectPool ObjectPool;
+
+// Create pool of items of 'item_size' bytes with space for 'capacity' items (at least 1).
+ObjectPool *object_pool_create(size_t item_size, uint32_t capacity);
+void object_pool_free(ObjectPool *pool);
+
+// Allocate zeroed item. Returns its handle and pointer in 'item' (may be NULL), or HANDLE_NONE
+// if memory is exhausted.
+Handle object_pool_alloc(ObjectPool *pool, void **item);
+// Free item. Returns false if the handle is stale.
+bool object_pool_release(ObjectPool *pool, Handle handle);
+// Pointer to item or NULL if the handle is stale. Valid until the next alloc or release.
+void *object_pool_get(const ObjectPool *pool, Handle handle);
+bool object_pool_contains(const ObjectPool *pool, Handle handle);
+void object_pool_clear(ObjectPool *pool);
+
+// Iteration: items are at object_pool_items(pool)[0 .. count-1] in no particular order.
+uint32_t object_pool_count(const ObjectPool *pool);
+void *object_pool_items(const ObjectPool *pool);
+// Handle of the item at given position of the items array
+Handle object_pool_handle_at(const ObjectPool *pool, uint32_t index);
+
+// Typed access
+#define OBJECT_POOL_CREATE(type, capacity) object_pool_create(sizeof(type), (capacity))
+#define OBJECT_POOL_GET(pool, type, handle) ((type *)object_pool_get((pool), (handle)))
+#define OBJECT_POOL_ITEMS(pool, type) ((type *)object_pool_items(pool))
+
+#endif
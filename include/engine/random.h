@@ -1,11 +1,44 @@
 #ifndef RANDOM_H
 #define RANDOM_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 // Generates a pseudo-random float in range [0, 1] based on given x and y coordinates.
 float rand01(int x, int y);
 // Generates a random 32-bit unsigned integer.
+//
+// Uses a global generator seeded from current time on first call (or by rand_seed).
+// Not thread-safe: worker threads should use their own Rng split from a parent one.
 uint32_t rand_big();
+// Seed the global generator used by rand_big. Same seed gives the same sequence.
+void rand_seed(uint64_t seed);
+
+// Pseudo-random number generator state (xoshiro128**).
+//
+// Fast, small and fully determined by its seed. Each thread should own its state.
+typedef struct {
+  uint32_t s[4];
+} Rng;
+
+// Initialize generator state from a 64-bit seed.
+void rng_seed(Rng *rng, uint64_t seed);
+// Next random 32-bit unsigned integer.
+uint32_t rng_next(Rng *rng);
+// Random float in range [0, 1).
+float rng_float01(Rng *rng);
+// Random integer in range [0, bound). Returns 0 if bound is 0.
+uint32_t rng_range(Rng *rng, uint32_t bound);
+
+// Create an independent stream from 'parent' (e.g. one per worker thread).
+//
+// Returned generator continues the parent sequence, while the parent jumps 2^64 steps ahead,
+// so streams created by sequential splits never overlap.
+Rng rng_split(Rng *parent);
+
+// Fill array with 'count' random 32-bit unsigned integers.
+void rng_fill_u32(Rng *rng, uint32_t *out, size_t count);
+// Fill array with 'count' random floats in range [0, 1).
+void rng_fill_float01(Rng *rng, float *out, size_t count);
 
 #endif
@@ -0,0 +1,33 @@
+#ifndef RENDER_LIST_H
+#define RENDER_LIST_H
+
+#include <engine/types.h>
+#include <stdbool.h>
+
+// Persistent list of objects to render, kept between frames.
+//
+// Objects are registered once and stay until unregistered; both are O(1).
+// Static objects (decoration, buildings) must not move or change sprite while registered. They are
+// kept depth-sorted with precomputed bounds, and the order is rebuilt only after static objects
+// are added or removed. Dynamic objects are sorted every frame and merged with the static ones,
+// so per-frame cost depends on dynamic count, not on the whole scene.
+//
+// To render, set it as RenderBatch 'render_list'.
+typedef struct RenderList RenderList;
+
+RenderList *render_list_create(void);
+void render_list_free(RenderList *list);
+
+// Register object. It is not copied, it must stay valid until removed or the list is freed.
+// Returns handle for removal or HANDLE_NONE on allocation failure.
+Handle render_list_add(RenderList *list, GameObject *obj);
+Handle render_list_add_static(RenderList *list, GameObject *obj);
+// Unregister object by handle returned from add. Stale handles are ignored.
+void render_list_remove(RenderList *list, Handle handle);
+void render_list_remove_static(RenderList *list, Handle handle);
+// Call after moving a static object or changing its sprite.
+void render_list_invalidate_static(RenderList *list);
+
+uint32_t render_list_count(const RenderList *list);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <engine/input.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Recording of a game session: random seed, logic tick rate and input of every logic tick.
+//
+// Game logic depends only on these, so replaying them reproduces the session exactly, as long as
+// the global generator is seeded with 'replay_seed' (see rand_seed) before the world is created
+// and the logic runs at 'replay_tick_rate'. Engine records and replays it (see engine.h), headless
+// engine replays at maximum speed.
+//
+// Input is stored run-length encoded: a run of ticks with the same pressed keys takes 12 bytes.
+typedef struct Replay Replay;
+
+// Bumped on any change of the file format
+#define REPLAY_VERSION 1
+
+// Create empty recording
+Replay *replay_create(uint64_t seed, float tick_rate);
+void replay_free(Replay *replay);
+
+// Append input of one logic tick. Returns false on allocation failure.
+bool replay_record(Replay *replay, const Input *input);
+// Read input of the next tick into 'input'. Returns false when all ticks are read.
+bool replay_next(Replay *replay, Input *input);
+// Start reading from the first tick again
+void replay_rewind(Replay *replay);
+
+uint64_t replay_seed(const Replay *replay);
+float replay_tick_rate(const Replay *replay);
+uint32_t replay_tick_count(const Replay *replay);
+
+// Save to binary file. Returns false on I/O error.
+bool replay_save(const Replay *replay, const char *path);
+// Load from file written by replay_save. Returns NULL on I/O error or unknown format.
+Replay *replay_load(const char *path);
+
+// Pressed keys as a bit mask, one bit per key in Input field order. 'quit' is not stored.
+uint64_t input_pack(const Input *input);
+Input input_unpack(uint64_t bits);
+
+#endif
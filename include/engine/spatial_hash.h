@@ -0,0 +1,36 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <engine/types.h>
+#include <stdint.h>
+
+// Spatial hash for neighbour queries over a set of points (e.g. object positions).
+//
+// World is split into square cells, points are grouped by cell. Queries check only cells
+// that overlap the query area, so the cost depends on local density, not on total count.
+// Rebuild it every logic step after positions are updated: rebuild is O(N).
+typedef struct SpatialHash SpatialHash;
+
+// Create spatial hash with given cell size in pixels.
+// Cell size should be about the typical query radius.
+// 'capacity' is initial number of points, it grows on rebuild if needed.
+SpatialHash *spatial_hash_create(float cell_size, uint32_t capacity);
+void spatial_hash_free(SpatialHash *sh);
+
+// Rebuild from array of positions. Query results are indices into this array.
+void spatial_hash_build(SpatialHash *sh, const Vector *positions, uint32_t count);
+// Rebuild from positions of objects array. Query results are indices into this array.
+void spatial_hash_build_objects(SpatialHash *sh, const GameObject *objects, uint32_t count);
+
+// Find points within 'radius' from 'center'.
+// Writes up to 'max_out' indices into 'out' and returns number of written indices.
+uint32_t spatial_hash_query_radius(const SpatialHash *sh,
+    Vector center,
+    float radius,
+    uint32_t *out,
+    uint32_t max_out);
+// Find points inside given rectangle.
+// Writes up to 'max_out' indices into 'out' and returns number of written indices.
+uint32_t spatial_hash_query_rect(const SpatialHash *sh, Rect rect, uint32_t *out, uint32_t max_out);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <SDL2/SDL_ttf.h>
+#include <engine/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Text rendering from cached glyphs.
+//
+// GlyphAtlas rasterizes printable ASCII glyphs of one font (font and size) once and stores their
+// coverage in a single buffer. Strings are then composed by copying cached glyphs, without SDL_ttf
+// rasterization or surface allocations. Glyphs are stored without color, it is given when drawing.
+// Characters without a glyph (including non-ASCII) are drawn as '?'.
+typedef struct GlyphAtlas GlyphAtlas;
+
+GlyphAtlas *glyph_atlas_create(TTF_Font *font);
+void glyph_atlas_free(GlyphAtlas *atlas);
+
+// Height of a line of text in pixels
+uint32_t glyph_atlas_line_height(const GlyphAtlas *atlas);
+// Width of 'text' in pixels
+uint32_t text_measure(const GlyphAtlas *atlas, const char *text);
+
+// Alpha-blend 'text' in ARGB 'color' into 'dst' (ARGB buffer of dst_width x dst_height).
+// (x, y) is top-left corner of the text. Parts outside of the buffer are clipped.
+void text_draw(const GlyphAtlas *atlas,
+    uint32_t *dst,
+    uint32_t dst_width,
+    uint32_t dst_height,
+    int x,
+    int y,
+    const char *text,
+    uint32_t color);
+
+// Sprite with text that is changed often (FPS counter, coordinates, ...).
+// Pixel buffer is reused and grows only when the text becomes larger than ever before.
+typedef struct {
+  Sprite sprite;
+  size_t capacity; // pixels allocated in sprite.pixels
+} TextLabel;
+
+// Compose 'text' in ARGB 'color' into label sprite. Returns false on allocation failure.
+bool text_label_set(TextLabel *label, const GlyphAtlas *atlas, const char *text, uint32_t color);
+void text_label_free(TextLabel *label);
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef TIMESTEP_H
+#define TIMESTEP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Default catch-up budget: 15 steps of 1/60 s is a quarter of a second of game time per frame.
+#define TICK_DEFAULT_MAX_TICKS 15
+
+// What to do when a frame took longer than 'max_ticks' logic steps ("spiral of death":
+// catching up takes more time than the frame, so the next frame is even later).
+typedef enum {
+  // Frame time is capped to the tick budget, so game time simply runs slower than real time.
+  TICK_OVERRUN_SLOW_MOTION,
+  // Ticks over the budget are thrown away and counted in 'skipped_ticks'.
+  TICK_OVERRUN_DROP,
+  // Nothing is thrown away: the backlog is caught up in the following frames (at most
+  // 'max_ticks' per frame). Only counters are updated, the user decides what to do.
+  TICK_OVERRUN_REPORT,
+} TickOverrunPolicy;
+
+typedef struct {
+  uint64_t ticks;          // logic steps run
+  uint64_t late_ticks;     // steps run to catch up, i.e. not the first step of a frame
+  uint64_t skipped_ticks;  // steps dropped by TICK_OVERRUN_DROP
+  uint64_t overrun_frames; // frames that needed more than 'max_ticks' steps
+} TickStats;
+
+// Fixed timestep scheduler. Real frame time is accumulated and converted into whole logic steps.
+typedef struct {
+  float step;         // seconds per logic step
+  uint32_t max_ticks; // most steps run in one frame
+  TickOverrunPolicy policy;
+  float accumulator; // real time not yet converted into steps
+  TickStats stats;
+} TickClock;
+
+// 'tick_rate' is number of logic steps per second.
+// Defaults: at most TICK_DEFAULT_MAX_TICKS steps per frame, TICK_OVERRUN_SLOW_MOTION.
+void tick_clock_init(TickClock *clock, float tick_rate);
+// Change step length at runtime. Returns false if 'tick_rate' is not positive.
+bool tick_clock_set_rate(TickClock *clock, float tick_rate);
+
+// Add 'frame_time' seconds and return number of logic steps to run now.
+uint32_t tick_clock_advance(TickClock *clock, float frame_time);
+// Fraction of a step passed since the last step, in [0, 1]. Used to interpolate rendering.
+float tick_clock_alpha(const TickClock *clock);
+
+#endif
@@ -14,6 +14,21 @@ typedef struct {
   uint32_t x, y;
 } VectorU32;
 
+// Stable reference to an item of a handle-based container (ObjectPool, EntityStore).
+// Stays valid while the item lives, even if the item moves in memory. Once the item is removed,
+// its slot gets a new generation, so old handles are detected as stale instead of pointing
+// to whatever reuses the slot. Zeroed handle is never valid.
+typedef struct {
+  uint32_t index;      // slot index
+  uint32_t generation; // slot generation at the time of creation, never 0 for valid handles
+} Handle;
+
+#define HANDLE_NONE ((Handle){0, 0})
+
+static inline bool handle_equal(Handle a, Handle b) {
+  return a.index == b.index && a.generation == b.generation;
+}
+
 typedef struct {
   uint32_t *pixels;
   uint32_t width;
@@ -32,6 +47,12 @@ typedef struct {
   // Needed only for convenience in movement calculations.
   // Doesn't used by engine, only by user.
   Vector pos_delta;
+
+  // Position at the previous logic step. If 'interpolate' is set, the object is drawn between
+  // 'prev_position' and 'position' according to time passed since the last logic step,
+  // so movement stays smooth when FPS is higher than logic rate.
+  Vector prev_position;
+  bool interpolate;
 } GameObject;
 
 typedef enum { UI_POS_SCREEN, UI_POS_ATTACHED } UIPositionMode;
@@ -60,6 +81,15 @@ typedef struct {
 
   UIElement **uis;
   uint32_t ui_count;
+
+  // Optional entity store (see engine/entity.h): all its live entities are rendered with 'objs',
+  // so entities may be added and removed without touching the batch
+  struct EntityStore *entities;
+  // Optional persistent render list (see engine/render_list.h), rendered with 'objs'
+  struct RenderList *render_list;
+
+  // Optional retained UI layer (see engine/ui.h), drawn over 'uis'
+  struct UILayer *ui_layer;
 } RenderBatch;
 
 // Load sprite from file and scale it.
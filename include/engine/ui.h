@@ -0,0 +1,25 @@
+#ifndef UI_H
+#define UI_H
+
+#include <engine/types.h>
+#include <stdbool.h>
+
+// Retained UI layer.
+//
+// Keeps registered UI elements sorted by z-index between frames. Neighbouring (in z order) elements
+// with UI_POS_SCREEN mode are composited once into a cached overlay, which is blended onto the frame
+// in a single pass. Overlay is recomposited only after one of its elements is invalidated.
+// Elements attached to objects move every frame, so they are drawn directly.
+typedef struct UILayer UILayer;
+
+UILayer *ui_layer_create(void);
+void ui_layer_free(UILayer *layer);
+
+// Register element. Element is not copied, it must stay valid until removed or the layer is freed.
+// Returns false on allocation failure.
+bool ui_layer_add(UILayer *layer, UIElement *ui);
+void ui_layer_remove(UILayer *layer, UIElement *ui);
+// Call after changing anything of a registered element: sprite pixels, size, position, mode or z-index.
+void ui_layer_invalidate(UILayer *layer, UIElement *ui);
+
+#endif
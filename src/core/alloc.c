@@ -0,0 +1,127 @@
+#include <engine/alloc.h>
+#include <engine/memory.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline size_t align_up(size_t size) {
+  return (size + ALLOC_ALIGN - 1) & ~(size_t)(ALLOC_ALIGN - 1);
+}
+
+// Memory returned by malloc is aligned only for standard types, so blocks are over-allocated
+// and their usable part starts at the first ALLOC_ALIGN boundary
+static inline uint8_t *align_ptr(void *ptr) {
+  return (uint8_t *)align_up((size_t)(uintptr_t)ptr);
+}
+
+// --- Arena ---
+
+// Overflow block, header is followed by data
+typedef struct OverflowBlock {
+  struct OverflowBlock *next;
+} OverflowBlock;
+
+struct Arena {
+  void *memory; // raw allocation
+  uint8_t *base; // aligned start of the main buffer
+  size_t capacity;
+  size_t offset; // used part of the main buffer
+
+  OverflowBlock *overflow;
+  size_t overflow_used; // bytes allocated in overflow blocks since last reset
+
+  ArenaStats stats;
+};
+
+static bool arena_set_capacity(Arena *arena, size_t capacity) {
+  void *memory = memory_alloc(MEMORY_RENDER, capacity + ALLOC_ALIGN);
+  if (!memory) return false;
+  memory_free(arena->memory);
+  arena->memory = memory;
+  arena->base = align_ptr(memory);
+  arena->capacity = capacity;
+  return true;
+}
+
+Arena *arena_create(size_t capacity) {
+  Arena *arena = calloc(1, sizeof(Arena));
+  if (!arena) return NULL;
+  if (!arena_set_capacity(arena, align_up(capacity))) {
+    free(arena);
+    return NULL;
+  }
+  return arena;
+}
+
+static void arena_free_overflow(Arena *arena) {
+  while (arena->overflow) {
+    OverflowBlock *next = arena->overflow->next;
+    memory_free(arena->overflow);
+    arena->overflow = next;
+  }
+  arena->overflow_used = 0;
+}
+
+void arena_free(Arena *arena) {
+  if (!arena) return;
+  arena_free_overflow(arena);
+  memory_free(arena->memory);
+  free(arena);
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+  if (!arena || size == 0) return NULL;
+  size = align_up(size);
+
+  void *ptr = NULL;
+  if (arena->capacity - arena->offset >= size) {
+    ptr = arena->base + arena->offset;
+    arena->offset += size;
+  } else {
+    // Every overflow allocation gets its own block; they are rare and released on reset
+    OverflowBlock *block = memory_alloc(MEMORY_RENDER, align_up(sizeof(OverflowBlock)) + size + ALLOC_ALIGN);
+    if (!block) return NULL;
+    block->next = arena->overflow;
+    arena->overflow = block;
+    arena->overflow_used += size;
+    arena->stats.overflows++;
+    ptr = align_ptr((uint8_t *)block + sizeof(OverflowBlock));
+  }
+
+  arena->stats.allocations++;
+  arena->stats.used = arena->offset + arena->overflow_used;
+  if (arena->stats.used > arena->stats.peak) arena->stats.peak = arena->stats.used;
+  return ptr;
+}
+
+void *arena_calloc(Arena *arena, size_t count, size_t size) {
+  if (size != 0 && count > SIZE_MAX / size) return NULL;
+  void *ptr = arena_alloc(arena, count * size);
+  if (ptr) memset(ptr, 0, count * size);
+  return ptr;
+}
+
+void arena_reset(Arena *arena) {
+  if (!arena) return;
+
+  // Grow to fit everything that was needed, so the next frame doesn't overflow again.
+  // If growing fails, the old buffer is kept.
+  if (arena->overflow) {
+    arena_free_overflow(arena);
+    arena_set_capacity(arena, align_up(arena->stats.peak));
+  }
+
+  arena->offset = 0;
+  arena->stats.used = 0;
+  arena->stats.allocations = 0;
+  arena->stats.resets++;
+}
+
+ArenaStats arena_stats(const Arena *arena) {
+  if (!arena) return (ArenaStats){0};
+  ArenaStats stats = arena->stats;
+  stats.capacity = arena->capacity;
+  return stats;
+}
@@ -3,21 +3,50 @@
 #include "graphics/render.h"
 #include "stb_image.h"
 #include "world/map_priv.h"
+#include <engine/alloc.h>
 #include <engine/coordinates.h>
 #include <engine/engine.h>
 #include <engine/input.h>
+#include <engine/jobs.h>
+#include <engine/memory.h>
+#include <engine/replay.h>
+#include <engine/timestep.h>
 #include <engine/types.h>
 #include <math.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#define BACKGROUND_COLOR 0xFF87CEEB
+
+// Camera drawn into a rectangle of the screen
+typedef struct {
+  bool active;
+  Camera *camera;     // camera->size is the viewport size
+  GameObject *target; // object followed by the camera, NULL - camera stays in place
+  int x, y;           // top-left corner of the viewport on screen
+  // Own render buffer, composed onto the screen after all views are drawn.
+  // NULL if this is the main view covering the whole screen, it draws straight into engine buffer.
+  uint32_t *pixels;
+} View;
 
 struct Engine {
-  Display *display;
+  Display *display; // NULL for headless engine
   Input input;
 
-  GameObject *player;
+  Replay *recording; // owned, input of every logic tick is appended
+  Replay *replay;    // not owned, logic ticks take input from it instead of the user
+
   Map *map;
-  Camera *camera;
+  JobSystem *jobs;
+
+  // View 0 always exists and is the main one: engine_set_player and engine_set_zoom change it,
+  // attached UI elements follow its camera
+  View views[ENGINE_MAX_VIEWS];
+  // Depth order and bounds of objects, shared by all views of a frame
+  RenderShared shared;
+  // Scratch memory of the current frame, released in engine_begin_frame
+  Arena *frame_arena;
 
   // Render buffer
   uint32_t *pixels;
@@ -27,57 +56,85 @@ struct Engine {
   // Time of last frame begin in milliseconds. Used only for fixed game logic timestep calculations.
   // Not used for FPS calculations.
   uint64_t last_frame_time;
-  // We accumulate time between updates for fixed game logic timestep
-  float accumulator;
+  // Converts frame time into fixed game logic steps
+  TickClock clock;
 
   // FPS is calculated based on the EMA (Exponential Moving Average) formula.
   // It smooths out sudden changes in frame time.
   float ema_delta_time;
+  // Time between last two frames in milliseconds and end time of the last one (headless engine only)
+  uint64_t delta_time;
+  uint64_t last_end_time;
+
+  // Periodic memory report, NULL if disabled (see engine_set_memory_dump)
+  FILE *memory_dump;
+  uint64_t memory_dump_interval; // milliseconds
+  uint64_t last_memory_dump;
 };
 
-Engine *engine_create(int width, int height, const char *title) {
-  if (!title || width <= 0 || height <= 0) return NULL;
+// Create engine with window if 'title' is set, headless otherwise
+static Engine *engine_create_impl(int width, int height, const char *title) {
+  if (width <= 0 || height <= 0) return NULL;
   Engine *e = calloc(1, sizeof(Engine));
   if (!e) return NULL;
 
   e->width = width;
   e->height = height;
 
-  e->display = display_create(width, height, 1.5f, title);
-  if (!e->display) {
-    free(e);
-    return NULL;
+  if (title) {
+    e->display = display_create(width, height, 1.5f, title);
+    if (!e->display) {
+      free(e);
+      return NULL;
+    }
   }
 
-  e->camera = camera_create(width, height);
-  if (!e->camera) {
+  e->views[0].camera = camera_create(width, height);
+  if (!e->views[0].camera) {
     display_free(e->display);
     free(e);
     return NULL;
   }
+  e->views[0].active = true;
 
   e->input = (Input){0};
 
-  // Allocate render buffer
-  e->pixels = calloc(width * height, sizeof(uint32_t));
-  if (!e->pixels) {
-    camera_free(e->camera);
+  // Allocate render buffer and frame memory
+  e->pixels = memory_calloc(MEMORY_RENDER, (size_t)width * height, sizeof(uint32_t));
+  e->frame_arena = arena_create(ENGINE_FRAME_ARENA_SIZE);
+  if (!e->pixels || !e->frame_arena) {
+    memory_free(e->pixels);
+    arena_free(e->frame_arena);
+    camera_free(e->views[0].camera);
     display_free(e->display);
     free(e);
     return NULL;
   }
 
+  // Without worker threads everything still works on the main thread, so failure is not fatal
+  e->jobs = jobs_create(0);
+
   e->last_frame_time = display_get_ticks();
-  e->accumulator = 0.0f;
+  e->last_end_time = e->last_frame_time;
+  tick_clock_init(&e->clock, ENGINE_DEFAULT_TICK_RATE);
   e->ema_delta_time = 1.0f / 60.0f; // initial FPS guess
 
   return e;
 }
 
+Engine *engine_create(int width, int height, const char *title) {
+  if (!title) return NULL;
+  return engine_create_impl(width, height, title);
+}
+
+Engine *engine_create_headless(int width, int height) {
+  return engine_create_impl(width, height, NULL);
+}
+
 void engine_set_player(Engine *e, GameObject *player) {
   if (!e || !player) return;
-  e->player = player;
-  e->camera->target = e->player->position;
+  e->views[0].target = player;
+  e->views[0].camera->target = player->position;
 }
 
 void engine_set_map(Engine *e, Map *map) {
@@ -89,8 +146,14 @@ void engine_free(Engine *e) {
   if (!e) return;
 
   if (e->display) display_free(e->display);
-  if (e->camera) camera_free(e->camera);
-  if (e->pixels) free(e->pixels);
+  for (int i = 0; i < ENGINE_MAX_VIEWS; i++) {
+    if (e->views[i].camera) camera_free(e->views[i].camera);
+    memory_free(e->views[i].pixels);
+  }
+  arena_free(e->frame_arena);
+  memory_free(e->pixels);
+  if (e->jobs) jobs_free(e->jobs);
+  replay_free(e->recording);
 
   free(e);
 }
@@ -98,49 +161,144 @@ void engine_free(Engine *e) {
 bool engine_begin_frame(Engine *e, void (*update)(Input *input, void *user_data), void *user_data) {
   if (!e) return false;
 
-  if (!display_poll_events(&e->input)) { return false; }
+  if (e->display && !display_poll_events(&e->input)) { return false; }
 
-  // Fixed timestep: measure frame time
-  uint64_t current_time = display_get_ticks();
-  float frame_time = (float)(current_time - e->last_frame_time) / 1000.0f;
-  e->last_frame_time = current_time;
+  // Nothing allocated during the previous frame outlives it
+  arena_reset(e->frame_arena);
 
-  // Cap framte time to avoid slowdown game
-  if (frame_time > 0.25f) frame_time = 0.25f;
+  uint32_t ticks = 1; // Headless engine runs one logic step per frame, as fast as possible
+  if (e->display) {
+    // Fixed timestep: measure frame time
+    uint64_t current_time = display_get_ticks();
+    float frame_time = (float)(current_time - e->last_frame_time) / 1000.0f;
+    e->last_frame_time = current_time;
 
-  e->accumulator += frame_time;
+    // Update logic at fixed rate. Long frames are handled according to overrun policy
+    ticks = tick_clock_advance(&e->clock, frame_time);
+  }
 
-  // Update logic at fixed rate (60 times per second)
-  while (e->accumulator >= ENGINE_LOGIC_STEP) {
-    update(&e->input, user_data);
-    e->accumulator -= ENGINE_LOGIC_STEP;
-    e->camera->target = e->player->position;
-    camera_update(e->camera, ENGINE_LOGIC_STEP);
+  for (uint32_t i = 0; i < ticks; i++) {
+    // User input is kept separately, so key states stay correct after replay ends
+    Input input = e->input;
+    if (e->replay && !replay_next(e->replay, &input)) return false;
+    if (e->recording) replay_record(e->recording, &input);
+
+    update(&input, user_data);
+    for (int v = 0; v < ENGINE_MAX_VIEWS; v++) {
+      View *view = &e->views[v];
+      if (!view->active) continue;
+      if (view->target) view->camera->target = view->target->position;
+      camera_update(view->camera, e->clock.step);
+    }
   }
 
   return true;
 }
 
+typedef struct {
+  Engine *e;
+  RenderBatch *batch;
+  float alpha;
+  View *views[ENGINE_MAX_VIEWS];
+} RenderViewsJob;
+
+// Draw map and objects of one view into its buffer
+static void render_view(Engine *e, View *view, RenderBatch *batch, float alpha) {
+  Camera camera = camera_interpolate(view->camera, alpha);
+  uint32_t *fb = view->pixels ? view->pixels : e->pixels;
+
+  uint32_t pixel_count = (uint32_t)camera.size.x * (uint32_t)camera.size.y;
+  for (uint32_t i = 0; i < pixel_count; i++) { fb[i] = BACKGROUND_COLOR; }
+
+  load_prerendered(fb, e->map, &camera);
+  render_view_objects(fb, batch, &e->shared, &camera, alpha);
+}
+
+static void render_views_range(uint32_t begin, uint32_t end, uint32_t worker, void *user_data) {
+  (void)worker;
+  RenderViewsJob *job = (RenderViewsJob *)user_data;
+  for (uint32_t i = begin; i < end; i++) { render_view(job->e, job->views[i], job->batch, job->alpha); }
+}
+
+// Copy view buffer into its rectangle on the screen
+static void compose_view(Engine *e, const View *view) {
+  int w = (int)view->camera->size.x, h = (int)view->camera->size.y;
+  int x0 = view->x < 0 ? -view->x : 0, y0 = view->y < 0 ? -view->y : 0;
+  int x1 = view->x + w > e->width ? e->width - view->x : w;
+  int y1 = view->y + h > e->height ? e->height - view->y : h;
+  if (x0 >= x1) return;
+
+  for (int y = y0; y < y1; y++) {
+    memcpy(e->pixels + (size_t)(view->y + y) * e->width + view->x + x0,
+        view->pixels + (size_t)y * w + x0,
+        (size_t)(x1 - x0) * sizeof(uint32_t));
+  }
+}
+
 void engine_render(Engine *e, RenderBatch *batch) {
   if (!e || !batch) return;
 
-  // Fill background
-  uint32_t bg_color = 0xFF87CEEB;
-  for (int i = 0; i < e->width * e->height; i++) { e->pixels[i] = bg_color; }
+  // Draw the world between two last logic steps, according to time left in accumulator
+  float alpha = tick_clock_alpha(&e->clock);
+
+  // Sort and bound objects once for all views
+  if (!render_prepare_objects(&e->shared, batch, e->frame_arena, alpha)) return;
+
+  RenderViewsJob job = {e, batch, alpha, {0}};
+  uint32_t view_count = 0;
+  for (int v = 0; v < ENGINE_MAX_VIEWS; v++) {
+    if (e->views[v].active) job.views[view_count++] = &e->views[v];
+  }
+  // Screen parts not covered by views show the background
+  if (e->views[0].pixels) {
+    size_t pixel_count = (size_t)e->width * e->height;
+    for (size_t i = 0; i < pixel_count; i++) { e->pixels[i] = BACKGROUND_COLOR; }
+  }
 
-  load_prerendered(e->pixels, e->map, e->camera);
+  // Views write to different buffers, so they are rasterized in parallel
+  jobs_parallel_for(e->jobs, view_count, 1, render_views_range, &job);
+  for (uint32_t i = 0; i < view_count; i++) {
+    if (job.views[i]->pixels) compose_view(e, job.views[i]);
+  }
 
-  // Render objects and UI
-  render_batch(e->pixels, batch, e->camera);
+  // UI covers the whole screen. Camera of the main view is extended to the screen, so
+  // attached elements stay over their objects.
+  View *main_view = &e->views[0];
+  Camera ui_camera = camera_interpolate(main_view->camera, alpha);
+  ui_camera.position.x -= main_view->x / ui_camera.zoom;
+  ui_camera.position.y -= main_view->y / ui_camera.zoom;
+  ui_camera.size = (Vector){(float)e->width, (float)e->height};
+  render_batch_ui(e->pixels, batch, &ui_camera, alpha);
 }
 
 void engine_end_frame(Engine *e) {
   if (!e) return;
-  display_present(e->display, e->pixels);
+  if (e->display) {
+    display_present(e->display, e->pixels);
+    e->delta_time = display_get_delta_time(e->display);
+  } else {
+    uint64_t current_time = display_get_ticks();
+    e->delta_time = current_time - e->last_end_time;
+    e->last_end_time = current_time;
+  }
 
   float alpha = 0.1f;
-  e->ema_delta_time =
-      e->ema_delta_time * (1.0f - alpha) + (display_get_delta_time(e->display) / 1000.0f) * alpha;
+  e->ema_delta_time = e->ema_delta_time * (1.0f - alpha) + (e->delta_time / 1000.0f) * alpha;
+
+  if (e->memory_dump) {
+    uint64_t now = display_get_ticks();
+    if (now - e->last_memory_dump >= e->memory_dump_interval) {
+      memory_dump(e->memory_dump);
+      e->last_memory_dump = now;
+    }
+  }
+}
+
+void engine_set_memory_dump(Engine *e, FILE *out, uint32_t interval_ms) {
+  if (!e) return;
+  e->memory_dump = out;
+  e->memory_dump_interval = interval_ms;
+  e->last_memory_dump = display_get_ticks();
 }
 
 float engine_get_fps(Engine *e) {
@@ -149,5 +307,151 @@ float engine_get_fps(Engine *e) {
 
 // Get time between last two displayed frames in milliseconds
 uint64_t engine_get_delta_time(Engine *e) {
-  return e ? (display_get_delta_time(e->display)) : 0;
+  return e ? e->delta_time : 0;
+}
+
+static inline bool is_valid_view(Engine *e, int view) {
+  return e && view >= 0 && view < ENGINE_MAX_VIEWS && e->views[view].active;
+}
+
+void engine_set_zoom(Engine *e, float zoom) {
+  engine_set_view_zoom(e, 0, zoom);
+}
+
+float engine_get_zoom(Engine *e) {
+  return e ? e->views[0].camera->zoom : 1.0f;
+}
+
+int engine_add_view(Engine *e, int x, int y, int width, int height, GameObject *target) {
+  if (!e || width <= 0 || height <= 0) return -1;
+
+  int index = -1;
+  for (int v = 1; v < ENGINE_MAX_VIEWS && index < 0; v++) {
+    if (!e->views[v].active) index = v;
+  }
+  if (index < 0) return -1;
+
+  View *view = &e->views[index];
+  view->camera = camera_create(width, height);
+  if (!view->camera) return -1;
+  view->active = true;
+  if (!engine_set_view_rect(e, index, x, y, width, height)) {
+    engine_remove_view(e, index);
+    return -1;
+  }
+
+  // Start centered on the target instead of flying to it from the world origin
+  view->target = target;
+  if (target) {
+    Camera *camera = view->camera;
+    camera->target = target->position;
+    camera->position.x = target->position.x - camera->size.x / 2.0f;
+    camera->position.y = target->position.y - camera->size.y / 2.0f;
+    camera->prev_position = camera->position;
+  }
+  return index;
+}
+
+void engine_remove_view(Engine *e, int view) {
+  if (!is_valid_view(e, view) || view == 0) return;
+
+  View *v = &e->views[view];
+  camera_free(v->camera);
+  memory_free(v->pixels);
+  *v = (View){0};
+}
+
+bool engine_set_view_rect(Engine *e, int view, int x, int y, int width, int height) {
+  if (!is_valid_view(e, view) || width <= 0 || height <= 0) return false;
+  View *v = &e->views[view];
+
+  // Full-screen main view draws straight into the screen buffer. Other views always have their own,
+  // so they never race with the main one and are composed over it in index order.
+  bool full_screen = view == 0 && x == 0 && y == 0 && width == e->width && height == e->height;
+  uint32_t *pixels = NULL;
+  if (!full_screen) {
+    pixels = memory_alloc(MEMORY_RENDER, (size_t)width * height * sizeof(uint32_t));
+    if (!pixels) return false;
+  }
+  memory_free(v->pixels);
+  v->pixels = pixels;
+
+  v->x = x;
+  v->y = y;
+  v->camera->size = (Vector){(float)width, (float)height};
+  return true;
+}
+
+void engine_set_view_target(Engine *e, int view, GameObject *target) {
+  if (!is_valid_view(e, view)) return;
+  e->views[view].target = target;
+}
+
+void engine_snap_view(Engine *e, int view) {
+  if (!is_valid_view(e, view)) return;
+  View *v = &e->views[view];
+  if (v->target) v->camera->target = v->target->position;
+  camera_snap(v->camera);
+}
+
+void engine_set_view_zoom(Engine *e, int view, float zoom) {
+  if (!is_valid_view(e, view)) return;
+  if (zoom < ENGINE_MIN_ZOOM) zoom = ENGINE_MIN_ZOOM;
+  if (zoom > ENGINE_MAX_ZOOM) zoom = ENGINE_MAX_ZOOM;
+  camera_set_zoom(e->views[view].camera, zoom);
+}
+
+bool engine_set_tick_rate(Engine *e, float tick_rate) {
+  return e ? tick_clock_set_rate(&e->clock, tick_rate) : false;
+}
+
+float engine_get_tick_step(Engine *e) {
+  return e ? e->clock.step : (1.0f / ENGINE_DEFAULT_TICK_RATE);
+}
+
+void engine_set_max_ticks_per_frame(Engine *e, uint32_t max_ticks) {
+  if (!e) return;
+  e->clock.max_ticks = max_ticks > 0 ? max_ticks : 1;
+}
+
+void engine_set_overrun_policy(Engine *e, TickOverrunPolicy policy) {
+  if (!e) return;
+  e->clock.policy = policy;
+}
+
+TickStats engine_get_tick_stats(Engine *e) {
+  return e ? e->clock.stats : (TickStats){0};
+}
+
+JobSystem *engine_get_jobs(Engine *e) {
+  return e ? e->jobs : NULL;
+}
+
+bool engine_start_recording(Engine *e, uint64_t seed) {
+  if (!e) return false;
+  Replay *recording = replay_create(seed, 1.0f / e->clock.step);
+  if (!recording) return false;
+  replay_free(e->recording);
+  e->recording = recording;
+  return true;
+}
+
+bool engine_save_recording(Engine *e, const char *path) {
+  if (!e || !e->recording) return false;
+  return replay_save(e->recording, path);
+}
+
+bool engine_play_replay(Engine *e, Replay *replay) {
+  if (!e) return false;
+  if (replay && !tick_clock_set_rate(&e->clock, replay_tick_rate(replay))) return false;
+  e->replay = replay;
+  return true;
+}
+
+const uint32_t *engine_get_pixels(Engine *e) {
+  return e ? e->pixels : NULL;
+}
+
+Arena *engine_get_frame_arena(Engine *e) {
+  return e ? e->frame_arena : NULL;
 }
@@ -0,0 +1,151 @@
+#include "slots_priv.h"
+#include <engine/entity.h>
+#include <engine/jobs.h>
+#include <engine/memory.h>
+#include <engine/types.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+EntityStore *entity_store_create(uint32_t capacity, size_t user_size) {
+  if (capacity == 0) return NULL;
+  EntityStore *store = calloc(1, sizeof(EntityStore));
+  if (!store) return NULL;
+
+  store->capacity = capacity;
+  store->user_size = user_size;
+  store->positions = memory_calloc(MEMORY_ENTITIES, capacity, sizeof(Vector));
+  store->velocities = memory_calloc(MEMORY_ENTITIES, capacity, sizeof(Vector));
+  store->sprites = memory_calloc(MEMORY_ENTITIES, capacity, sizeof(Sprite *));
+  store->anims = memory_calloc(MEMORY_ENTITIES, capacity, sizeof(EntityAnim));
+  store->objects = memory_calloc(MEMORY_ENTITIES, capacity, sizeof(GameObject));
+  if (user_size > 0) store->user = memory_calloc(MEMORY_ENTITIES, capacity, user_size);
+  store->table = malloc(sizeof(SlotTable));
+  if (store->table && !slot_table_init(store->table, capacity)) {
+    free(store->table);
+    store->table = NULL;
+  }
+
+  if (!store->positions || !store->velocities || !store->sprites || !store->anims || !store->objects ||
+      (user_size > 0 && !store->user) || !store->table) {
+    entity_store_free(store);
+    return NULL;
+  }
+
+  return store;
+}
+
+void entity_store_free(EntityStore *store) {
+  if (!store) return;
+
+  memory_free(store->positions);
+  memory_free(store->velocities);
+  memory_free(store->sprites);
+  memory_free(store->anims);
+  memory_free(store->user);
+  memory_free(store->objects);
+  if (store->table) slot_table_free(store->table);
+  free(store->table);
+  free(store);
+}
+
+Handle entity_store_add(EntityStore *store, Vector position, Sprite *sprite) {
+  if (!store) return HANDLE_NONE;
+  Handle entity = slot_table_add(store->table);
+  if (entity.generation == 0) return HANDLE_NONE;
+
+  uint32_t idx = store->count++;
+  store->positions[idx] = position;
+  store->velocities[idx] = (Vector){0.0f, 0.0f};
+  store->sprites[idx] = sprite;
+  store->anims[idx] = (EntityAnim){0};
+  if (store->user_size > 0) memset(entity_store_user(store, idx), 0, store->user_size);
+
+  GameObject *obj = &store->objects[entity.index];
+  *obj = (GameObject){0};
+  obj->position = position;
+  obj->prev_position = position;
+  obj->interpolate = true;
+  obj->cur_sprite = sprite;
+
+  return entity;
+}
+
+bool entity_store_remove(EntityStore *store, Handle entity) {
+  if (!store) return false;
+  uint32_t index = slot_table_remove(store->table, entity);
+  if (index == SLOT_INVALID) return false;
+
+  // Render object stays in its slot, only packed components are moved
+  uint32_t last = --store->count;
+  if (index == last) return true;
+
+  store->positions[index] = store->positions[last];
+  store->velocities[index] = store->velocities[last];
+  store->sprites[index] = store->sprites[last];
+  store->anims[index] = store->anims[last];
+  if (store->user_size > 0) {
+    memcpy(entity_store_user(store, index), entity_store_user(store, last), store->user_size);
+  }
+  return true;
+}
+
+uint32_t entity_store_index(const EntityStore *store, Handle entity) {
+  if (!store) return ENTITY_NONE;
+  uint32_t index = slot_table_lookup(store->table, entity);
+  return index == SLOT_INVALID ? ENTITY_NONE : index;
+}
+
+Handle entity_store_handle(const EntityStore *store, uint32_t index) {
+  return store ? slot_table_handle(store->table, index) : HANDLE_NONE;
+}
+
+GameObject *entity_store_object(const EntityStore *store, Handle entity) {
+  if (entity_store_index(store, entity) == ENTITY_NONE) return NULL;
+  return &store->objects[entity.index];
+}
+
+GameObject *entity_store_object_at(const EntityStore *store, uint32_t index) {
+  if (!store || index >= store->count) return NULL;
+  return &store->objects[store->table->slots[index]];
+}
+
+void entity_store_run(EntityStore *store, EntitySystem system, void *user_data) {
+  if (!store || !system || store->count == 0) return;
+  system(store, 0, store->count, 0, user_data);
+}
+
+typedef struct {
+  EntityStore *store;
+  EntitySystem system;
+  void *user_data;
+} SystemJob;
+
+static void run_system_range(uint32_t begin, uint32_t end, uint32_t worker, void *user_data) {
+  SystemJob *job = (SystemJob *)user_data;
+  job->system(job->store, begin, end, worker, job->user_data);
+}
+
+void entity_store_run_parallel(EntityStore *store,
+    JobSystem *jobs,
+    uint32_t grain,
+    EntitySystem system,
+    void *user_data) {
+  if (!store || !system || store->count == 0) return;
+
+  SystemJob job = {store, system, user_data};
+  jobs_parallel_for(jobs, store->count, grain, run_system_range, &job);
+}
+
+void entity_store_sync_objects(EntityStore *store) {
+  if (!store) return;
+
+  const uint32_t *slots = store->table->slots;
+  for (uint32_t i = 0; i < store->count; i++) {
+    GameObject *obj = &store->objects[slots[i]];
+    obj->prev_position = obj->position;
+    obj->position = store->positions[i];
+    obj->cur_sprite = store->sprites[i];
+    obj->pos_delta = store->velocities[i];
+  }
+}
@@ -0,0 +1,185 @@
+#include <SDL2/SDL.h>
+#include <engine/jobs.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define JOBS_MAX_WORKERS 64
+#define CACHE_LINE 64
+
+// Chunks owned by one participant: [next, end). 'next' is advanced atomically both by the owner
+// and by thieves, so every chunk is taken exactly once.
+// Padded to a cache line, so participants don't slow each other down on shared counters.
+typedef struct {
+  SDL_atomic_t next;
+  uint32_t end;
+  char pad[CACHE_LINE - sizeof(SDL_atomic_t) - sizeof(uint32_t)];
+} Partition;
+
+typedef struct {
+  JobSystem *js;
+  uint32_t index;
+} WorkerArg;
+
+struct JobSystem {
+  uint32_t worker_count; // participants including calling thread
+  SDL_Thread **threads;  // worker_count - 1 background threads
+  WorkerArg *args;
+
+  SDL_mutex *mutex;
+  SDL_cond *start_cond; // signalled when a new job is published
+  SDL_cond *done_cond;  // signalled when the last worker finishes the job
+  uint64_t generation;  // incremented for every job
+  uint32_t active;      // background workers still running current job
+  bool quit;
+
+  // Current job
+  JobRangeFunc fn;
+  void *user_data;
+  uint32_t count;
+  uint32_t grain;
+  Partition *parts;
+};
+
+static inline bool take_chunk(Partition *part, uint32_t *chunk) {
+  if ((uint32_t)SDL_AtomicGet(&part->next) >= part->end) return false;
+  uint32_t c = (uint32_t)SDL_AtomicAdd(&part->next, 1);
+  if (c >= part->end) return false;
+  *chunk = c;
+  return true;
+}
+
+static inline void run_chunk(JobSystem *js, uint32_t chunk, uint32_t worker) {
+  uint32_t begin = chunk * js->grain;
+  uint32_t end = begin + js->grain;
+  if (end > js->count) end = js->count;
+  js->fn(begin, end, worker, js->user_data);
+}
+
+// Process own chunks first, then steal from other participants
+static void participate(JobSystem *js, uint32_t worker) {
+  uint32_t chunk;
+  while (take_chunk(&js->parts[worker], &chunk)) { run_chunk(js, chunk, worker); }
+
+  for (uint32_t i = 1; i < js->worker_count; i++) {
+    Partition *victim = &js->parts[(worker + i) % js->worker_count];
+    while (take_chunk(victim, &chunk)) { run_chunk(js, chunk, worker); }
+  }
+}
+
+static int worker_main(void *arg) {
+  WorkerArg *wa = (WorkerArg *)arg;
+  JobSystem *js = wa->js;
+  uint64_t seen = 0;
+
+  for (;;) {
+    SDL_LockMutex(js->mutex);
+    while (!js->quit && js->generation == seen) { SDL_CondWait(js->start_cond, js->mutex); }
+    if (js->quit) {
+      SDL_UnlockMutex(js->mutex);
+      return 0;
+    }
+    seen = js->generation;
+    SDL_UnlockMutex(js->mutex);
+
+    participate(js, wa->index);
+
+    SDL_LockMutex(js->mutex);
+    if (--js->active == 0) SDL_CondSignal(js->done_cond);
+    SDL_UnlockMutex(js->mutex);
+  }
+}
+
+JobSystem *jobs_create(int worker_count) {
+  if (worker_count <= 0) worker_count = SDL_GetCPUCount();
+  if (worker_count < 1) worker_count = 1;
+  if (worker_count > JOBS_MAX_WORKERS) worker_count = JOBS_MAX_WORKERS;
+
+  JobSystem *js = calloc(1, sizeof(JobSystem));
+  if (!js) return NULL;
+  js->worker_count = (uint32_t)worker_count;
+
+  js->parts = calloc(js->worker_count, sizeof(Partition));
+  js->threads = calloc(js->worker_count, sizeof(SDL_Thread *));
+  js->args = calloc(js->worker_count, sizeof(WorkerArg));
+  js->mutex = SDL_CreateMutex();
+  js->start_cond = SDL_CreateCond();
+  js->done_cond = SDL_CreateCond();
+  if (!js->parts || !js->threads || !js->args || !js->mutex || !js->start_cond || !js->done_cond) {
+    jobs_free(js);
+    return NULL;
+  }
+
+  for (uint32_t i = 1; i < js->worker_count; i++) {
+    js->args[i] = (WorkerArg){js, i};
+    js->threads[i] = SDL_CreateThread(worker_main, "engine_worker", &js->args[i]);
+    if (!js->threads[i]) {
+      // Continue with threads that were created
+      js->worker_count = i;
+      break;
+    }
+  }
+
+  return js;
+}
+
+void jobs_free(JobSystem *js) {
+  if (!js) return;
+
+  if (js->mutex) {
+    SDL_LockMutex(js->mutex);
+    js->quit = true;
+    if (js->start_cond) SDL_CondBroadcast(js->start_cond);
+    SDL_UnlockMutex(js->mutex);
+  }
+  if (js->threads) {
+    for (uint32_t i = 1; i < js->worker_count; i++) {
+      if (js->threads[i]) SDL_WaitThread(js->threads[i], NULL);
+    }
+  }
+
+  if (js->done_cond) SDL_DestroyCond(js->done_cond);
+  if (js->start_cond) SDL_DestroyCond(js->start_cond);
+  if (js->mutex) SDL_DestroyMutex(js->mutex);
+  free(js->args);
+  free(js->threads);
+  free(js->parts);
+  free(js);
+}
+
+uint32_t jobs_worker_count(JobSystem *js) {
+  return js ? js->worker_count : 1;
+}
+
+void jobs_parallel_for(JobSystem *js, uint32_t count, uint32_t grain, JobRangeFunc fn, void *user_data) {
+  if (!fn || count == 0) return;
+  if (grain == 0) grain = 1;
+
+  // Nothing to share: run on calling thread without waking workers
+  uint32_t chunks = (count + grain - 1) / grain;
+  if (!js || js->worker_count == 1 || chunks == 1) {
+    fn(0, count, 0, user_data);
+    return;
+  }
+
+  js->fn = fn;
+  js->user_data = user_data;
+  js->count = count;
+  js->grain = grain;
+  for (uint32_t w = 0; w < js->worker_count; w++) {
+    SDL_AtomicSet(&js->parts[w].next, (int)((uint64_t)chunks * w / js->worker_count));
+    js->parts[w].end = (uint32_t)((uint64_t)chunks * (w + 1) / js->worker_count);
+  }
+
+  SDL_LockMutex(js->mutex);
+  js->active = js->worker_count - 1;
+  js->generation++;
+  SDL_CondBroadcast(js->start_cond);
+  SDL_UnlockMutex(js->mutex);
+
+  participate(js, 0);
+
+  SDL_LockMutex(js->mutex);
+  while (js->active > 0) { SDL_CondWait(js->done_cond, js->mutex); }
+  SDL_UnlockMutex(js->mutex);
+}
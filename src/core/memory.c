@@ -0,0 +1,202 @@
+#include <SDL2/SDL.h>
+#include <engine/memory.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef struct {
+  MemoryCategory category;
+  size_t size;
+} TrackedBuffer;
+
+typedef struct {
+  const void *key; // NULL - empty slot
+  TrackedBuffer value;
+} TrackedEntry;
+
+// All tracked buffers by address: open addressing with linear probing, at most half full.
+// Guarded by 'lock', as assets may be loaded from worker threads.
+static TrackedEntry *tracked = NULL;
+static size_t tracked_capacity = 0; // power of two
+static size_t tracked_count = 0;
+static MemoryStats stats;
+static SDL_SpinLock lock;
+
+static const char *category_names[MEMORY_CATEGORY_COUNT] = {
+    "map", "sprites", "text", "ui", "entities", "render"};
+
+static size_t slot_of(const void *ptr) {
+  // Allocations are aligned, low bits carry no information
+  uint64_t h = ((uint64_t)(uintptr_t)ptr >> 4) * 0x9E3779B97F4A7C15ull;
+  return (size_t)(h >> 32) & (tracked_capacity - 1);
+}
+
+static TrackedEntry *find_entry(const void *ptr) {
+  if (tracked_count == 0) return NULL;
+  for (size_t i = slot_of(ptr);; i = (i + 1) & (tracked_capacity - 1)) {
+    if (tracked[i].key == ptr) return &tracked[i];
+    if (!tracked[i].key) return NULL;
+  }
+}
+
+static void insert_entry(const void *ptr, TrackedBuffer buf) {
+  size_t i = slot_of(ptr);
+  while (tracked[i].key) i = (i + 1) & (tracked_capacity - 1);
+  tracked[i] = (TrackedEntry){ptr, buf};
+  tracked_count++;
+}
+
+static bool grow_table(void) {
+  size_t old_capacity = tracked_capacity;
+  TrackedEntry *old = tracked;
+  TrackedEntry *entries = calloc(old_capacity ? old_capacity * 2 : 256, sizeof(TrackedEntry));
+  if (!entries) return false;
+  tracked = entries;
+  tracked_capacity = old_capacity ? old_capacity * 2 : 256;
+  tracked_count = 0;
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (old[i].key) insert_entry(old[i].key, old[i].value);
+  }
+  free(old);
+  return true;
+}
+
+// Remove entry and shift the following entries of its probe run back, so lookups need no tombstones
+static void remove_entry(TrackedEntry *entry) {
+  size_t mask = tracked_capacity - 1;
+  size_t hole = (size_t)(entry - tracked);
+  for (size_t i = (hole + 1) & mask; tracked[i].key; i = (i + 1) & mask) {
+    size_t home = slot_of(tracked[i].key);
+    // Entry may fill the hole only if the hole lies between its home slot and its position
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      tracked[hole] = tracked[i];
+      hole = i;
+    }
+  }
+  tracked[hole].key = NULL;
+  tracked_count--;
+}
+
+// Remove buffer from the counters. Must be called with 'lock' held. Returns false if it is not tracked.
+static bool untrack_locked(const void *ptr, TrackedBuffer *removed) {
+  TrackedEntry *entry = find_entry(ptr);
+  if (!entry) return false;
+  TrackedBuffer buf = entry->value;
+  if (removed) *removed = buf;
+  MemoryUsage *usage = &stats.categories[buf.category];
+  usage->current -= buf.size;
+  usage->blocks--;
+  stats.current -= buf.size;
+  remove_entry(entry);
+  return true;
+}
+
+// Add buffer to the counters. Must be called with 'lock' held. Buffers are identified by address only,
+// their contents are never touched. 'is_new' - count it as an allocation; otherwise the buffer was
+// counted before and is only put back.
+static void track_locked(MemoryCategory category, const void *ptr, size_t size, bool is_new) {
+  untrack_locked(ptr, NULL);
+  // Without room in the table the buffer is just not counted
+  if ((tracked_count + 1) * 2 > tracked_capacity && !grow_table()) return;
+  insert_entry(ptr, (TrackedBuffer){category, size});
+
+  MemoryUsage *usage = &stats.categories[category];
+  usage->current += size;
+  usage->blocks++;
+  if (is_new) usage->allocations++;
+  // A buffer put back was already part of the peaks, unless other buffers were allocated meanwhile
+  if (usage->current > usage->peak) usage->peak = usage->current;
+  stats.current += size;
+  if (stats.current > stats.peak) stats.peak = stats.current;
+}
+
+static void track_address(MemoryCategory category, uintptr_t address, size_t size) {
+  const void *ptr = (const void *)address;
+  if (!ptr || category >= MEMORY_CATEGORY_COUNT) return;
+  SDL_AtomicLock(&lock);
+  track_locked(category, ptr, size, true);
+  SDL_AtomicUnlock(&lock);
+}
+
+void memory_track(MemoryCategory category, const void *ptr, size_t size) {
+  track_address(category, (uintptr_t)ptr, size);
+}
+
+void memory_untrack(const void *ptr) {
+  if (!ptr) return;
+  SDL_AtomicLock(&lock);
+  untrack_locked(ptr, NULL);
+  SDL_AtomicUnlock(&lock);
+}
+
+void *memory_alloc(MemoryCategory category, size_t size) {
+  void *ptr = malloc(size);
+  track_address(category, (uintptr_t)ptr, size);
+  return ptr;
+}
+
+void *memory_calloc(MemoryCategory category, size_t count, size_t size) {
+  void *ptr = calloc(count, size);
+  track_address(category, (uintptr_t)ptr, count * size);
+  return ptr;
+}
+
+void *memory_realloc(MemoryCategory category, void *ptr, size_t size) {
+  // Untrack before the old address is released, another thread may get it from malloc right after
+  TrackedBuffer old = {0};
+  SDL_AtomicLock(&lock);
+  bool was_tracked = ptr && untrack_locked(ptr, &old);
+  SDL_AtomicUnlock(&lock);
+
+  void *grown = realloc(ptr, size);
+  if (!grown && size > 0) {
+    // The old buffer is still alive: put its entry back, it is not a new allocation
+    if (was_tracked) {
+      SDL_AtomicLock(&lock);
+      track_locked(old.category, ptr, old.size, false);
+      SDL_AtomicUnlock(&lock);
+    }
+    return NULL;
+  }
+  track_address(category, (uintptr_t)grown, size);
+  return grown;
+}
+
+void memory_free(void *ptr) {
+  if (!ptr) return;
+  memory_untrack(ptr);
+  free(ptr);
+}
+
+MemoryStats memory_get_stats(void) {
+  SDL_AtomicLock(&lock);
+  MemoryStats copy = stats;
+  SDL_AtomicUnlock(&lock);
+  return copy;
+}
+
+MemoryUsage memory_get_usage(MemoryCategory category) {
+  MemoryUsage usage = {0};
+  if (category >= MEMORY_CATEGORY_COUNT) return usage;
+  SDL_AtomicLock(&lock);
+  usage = stats.categories[category];
+  SDL_AtomicUnlock(&lock);
+  return usage;
+}
+
+const char *memory_category_name(MemoryCategory category) {
+  if (category >= MEMORY_CATEGORY_COUNT) return "unknown";
+  return category_names[category];
+}
+
+void memory_dump(FILE *out) {
+  if (!out) return;
+  MemoryStats s = memory_get_stats();
+  fprintf(out, "%-10s %12s %12s %8s\n", "memory", "current, KB", "peak, KB", "blocks");
+  for (int i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+    const MemoryUsage *u = &s.categories[i];
+    double current = u->current / 1024.0, peak = u->peak / 1024.0;
+    fprintf(out, "%-10s %12.1f %12.1f %8u\n", category_names[i], current, peak, u->blocks);
+  }
+  fprintf(out, "%-10s %12.1f %12.1f\n", "total", s.current / 1024.0, s.peak / 1024.0);
+}
@@ -0,0 +1,103 @@
+#include "slots_priv.h"
+#include <engine/memory.h>
+#include <engine/object_pool.h>
+#include <engine/types.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct ObjectPool {
+  SlotTable table;
+  char *items; // table.count items packed, space for 'capacity'
+  size_t item_size;
+  uint32_t capacity;
+};
+
+ObjectPool *object_pool_create(size_t item_size, uint32_t capacity) {
+  if (item_size == 0) return NULL;
+  if (capacity == 0) capacity = 1;
+
+  ObjectPool *pool = calloc(1, sizeof(ObjectPool));
+  if (!pool) return NULL;
+  pool->item_size = item_size;
+  pool->capacity = capacity;
+  pool->items = memory_alloc(MEMORY_ENTITIES, item_size * capacity);
+  if (!pool->items || !slot_table_init(&pool->table, capacity)) {
+    object_pool_free(pool);
+    return NULL;
+  }
+  return pool;
+}
+
+void object_pool_free(ObjectPool *pool) {
+  if (!pool) return;
+  slot_table_free(&pool->table);
+  memory_free(pool->items);
+  free(pool);
+}
+
+static inline void *item_at(const ObjectPool *pool, uint32_t index) {
+  return pool->items + (size_t)index * pool->item_size;
+}
+
+static bool object_pool_grow(ObjectPool *pool) {
+  if (pool->capacity > UINT32_MAX / 4) return false;
+  uint32_t capacity = pool->capacity * 2;
+  char *items = memory_realloc(MEMORY_ENTITIES, pool->items, pool->item_size * capacity);
+  if (!items) return false;
+  pool->items = items;
+  if (!slot_table_grow(&pool->table, capacity)) return false;
+  pool->capacity = capacity;
+  return true;
+}
+
+Handle object_pool_alloc(ObjectPool *pool, void **item) {
+  if (item) *item = NULL;
+  if (!pool) return HANDLE_NONE;
+  if (pool->table.count == pool->capacity && !object_pool_grow(pool)) return HANDLE_NONE;
+
+  Handle handle = slot_table_add(&pool->table);
+  void *ptr = item_at(pool, pool->table.count - 1);
+  memset(ptr, 0, pool->item_size);
+  if (item) *item = ptr;
+  return handle;
+}
+
+bool object_pool_release(ObjectPool *pool, Handle handle) {
+  if (!pool) return false;
+  uint32_t index = slot_table_remove(&pool->table, handle);
+  if (index == SLOT_INVALID) return false;
+
+  uint32_t last = pool->table.count;
+  if (index != last) memcpy(item_at(pool, index), item_at(pool, last), pool->item_size);
+  return true;
+}
+
+void *object_pool_get(const ObjectPool *pool, Handle handle) {
+  if (!pool) return NULL;
+  uint32_t index = slot_table_lookup(&pool->table, handle);
+  return index == SLOT_INVALID ? NULL : item_at(pool, index);
+}
+
+bool object_pool_contains(const ObjectPool *pool, Handle handle) {
+  return object_pool_get(pool, handle) != NULL;
+}
+
+void object_pool_clear(ObjectPool *pool) {
+  if (!pool) return;
+  // Release one by one, so every slot gets a new generation and old handles become stale
+  while (pool->table.count > 0) {
+    slot_table_remove(&pool->table, slot_table_handle(&pool->table, pool->table.count - 1));
+  }
+}
+
+uint32_t object_pool_count(const ObjectPool *pool) {
+  return pool ? pool->table.count : 0;
+}
+
+void *object_pool_items(const ObjectPool *pool) {
+  return pool ? pool->items : NULL;
+}
+
+Handle object_pool_handle_at(const ObjectPool *pool, uint32_t index) {
+  return pool ? slot_table_handle(&pool->table, index) : HANDLE_NONE;
+}
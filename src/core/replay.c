@@ -0,0 +1,220 @@
+#include <engine/input.h>
+#include <engine/replay.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_MAGIC "RPLY"
+#define REPLAY_RUN_BYTES 12 // ticks (u32) and keys (u64)
+
+// Consecutive ticks with the same input
+typedef struct {
+  uint32_t ticks;
+  uint64_t keys;
+} InputRun;
+
+struct Replay {
+  uint64_t seed;
+  float tick_rate;
+  uint32_t tick_count;
+
+  InputRun *runs;
+  uint32_t run_count;
+  uint32_t run_capacity;
+
+  // Read position: tick 'tick_in_run' of run 'run'
+  uint32_t run;
+  uint32_t tick_in_run;
+};
+
+// Keys in Input field order. Bit i of packed input is the key at key_offsets[i].
+static const size_t key_offsets[] = {
+    offsetof(Input, up), offsetof(Input, down), offsetof(Input, left), offsetof(Input, right),
+    offsetof(Input, q), offsetof(Input, w), offsetof(Input, e), offsetof(Input, r), offsetof(Input, t),
+    offsetof(Input, y), offsetof(Input, u), offsetof(Input, i), offsetof(Input, o), offsetof(Input, p),
+    offsetof(Input, a), offsetof(Input, s), offsetof(Input, d), offsetof(Input, f), offsetof(Input, g),
+    offsetof(Input, h), offsetof(Input, j), offsetof(Input, k), offsetof(Input, l), offsetof(Input, z),
+    offsetof(Input, x), offsetof(Input, c), offsetof(Input, v), offsetof(Input, b), offsetof(Input, n),
+    offsetof(Input, m), offsetof(Input, space), offsetof(Input, enter), offsetof(Input, lctrl),
+    offsetof(Input, lshift)};
+#define KEY_COUNT (sizeof(key_offsets) / sizeof(key_offsets[0]))
+
+uint64_t input_pack(const Input *input) {
+  if (!input) return 0;
+  uint64_t bits = 0;
+  for (uint32_t i = 0; i < KEY_COUNT; i++) {
+    if (*(const bool *)((const char *)input + key_offsets[i])) bits |= 1ull << i;
+  }
+  return bits;
+}
+
+Input input_unpack(uint64_t bits) {
+  Input input = {0};
+  for (uint32_t i = 0; i < KEY_COUNT; i++) {
+    *(bool *)((char *)&input + key_offsets[i]) = (bits >> i) & 1;
+  }
+  return input;
+}
+
+Replay *replay_create(uint64_t seed, float tick_rate) {
+  Replay *replay = calloc(1, sizeof(Replay));
+  if (!replay) return NULL;
+  replay->seed = seed;
+  replay->tick_rate = tick_rate;
+  return replay;
+}
+
+void replay_free(Replay *replay) {
+  if (!replay) return;
+  free(replay->runs);
+  free(replay);
+}
+
+static bool reserve_runs(Replay *replay, uint32_t count) {
+  if (count <= replay->run_capacity) return true;
+  uint32_t capacity = replay->run_capacity ? replay->run_capacity : 64;
+  while (capacity < count) capacity = capacity <= UINT32_MAX / 2 ? capacity * 2 : count;
+  InputRun *runs = realloc(replay->runs, (size_t)capacity * sizeof(InputRun));
+  if (!runs) return false;
+  replay->runs = runs;
+  replay->run_capacity = capacity;
+  return true;
+}
+
+bool replay_record(Replay *replay, const Input *input) {
+  if (!replay || !input || replay->tick_count == UINT32_MAX) return false;
+  uint64_t keys = input_pack(input);
+
+  InputRun *last = replay->run_count ? &replay->runs[replay->run_count - 1] : NULL;
+  if (last && last->keys == keys && last->ticks < UINT32_MAX) {
+    last->ticks++;
+  } else {
+    if (!reserve_runs(replay, replay->run_count + 1)) return false;
+    replay->runs[replay->run_count++] = (InputRun){1, keys};
+  }
+  replay->tick_count++;
+  return true;
+}
+
+bool replay_next(Replay *replay, Input *input) {
+  if (!replay || replay->run >= replay->run_count) return false;
+
+  InputRun *run = &replay->runs[replay->run];
+  if (input) *input = input_unpack(run->keys);
+  if (++replay->tick_in_run >= run->ticks) {
+    replay->run++;
+    replay->tick_in_run = 0;
+  }
+  return true;
+}
+
+void replay_rewind(Replay *replay) {
+  if (!replay) return;
+  replay->run = 0;
+  replay->tick_in_run = 0;
+}
+
+uint64_t replay_seed(const Replay *replay) {
+  return replay ? replay->seed : 0;
+}
+
+float replay_tick_rate(const Replay *replay) {
+  return replay ? replay->tick_rate : 0.0f;
+}
+
+uint32_t replay_tick_count(const Replay *replay) {
+  return replay ? replay->tick_count : 0;
+}
+
+// File is little-endian regardless of the host:
+//   magic "RPLY", u32 version, u64 seed, f32 tick rate, u32 run count, runs of (u32 ticks, u64 keys)
+
+static bool write_u32(FILE *f, uint32_t v) {
+  uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+  return fwrite(b, 1, 4, f) == 4;
+}
+
+static bool write_u64(FILE *f, uint64_t v) {
+  return write_u32(f, (uint32_t)v) && write_u32(f, (uint32_t)(v >> 32));
+}
+
+static bool read_u32(FILE *f, uint32_t *v) {
+  uint8_t b[4];
+  if (fread(b, 1, 4, f) != 4) return false;
+  *v = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+  return true;
+}
+
+// Bytes between the current position and the end of file, -1 on error
+static long bytes_left(FILE *f) {
+  long pos = ftell(f);
+  if (pos < 0 || fseek(f, 0, SEEK_END) != 0) return -1;
+  long end = ftell(f);
+  if (end < pos || fseek(f, pos, SEEK_SET) != 0) return -1;
+  return end - pos;
+}
+
+static bool read_u64(FILE *f, uint64_t *v) {
+  uint32_t lo, hi;
+  if (!read_u32(f, &lo) || !read_u32(f, &hi)) return false;
+  *v = (uint64_t)lo | ((uint64_t)hi << 32);
+  return true;
+}
+
+bool replay_save(const Replay *replay, const char *path) {
+  if (!replay || !path) return false;
+  FILE *f = fopen(path, "wb");
+  if (!f) return false;
+
+  uint32_t rate_bits;
+  memcpy(&rate_bits, &replay->tick_rate, sizeof(rate_bits));
+  bool ok = fwrite(REPLAY_MAGIC, 1, 4, f) == 4 && write_u32(f, REPLAY_VERSION) &&
+      write_u64(f, replay->seed) && write_u32(f, rate_bits) && write_u32(f, replay->run_count);
+  for (uint32_t i = 0; ok && i < replay->run_count; i++) {
+    ok = write_u32(f, replay->runs[i].ticks) && write_u64(f, replay->runs[i].keys);
+  }
+
+  if (fclose(f) != 0) ok = false;
+  return ok;
+}
+
+Replay *replay_load(const char *path) {
+  if (!path) return NULL;
+  FILE *f = fopen(path, "rb");
+  if (!f) return NULL;
+
+  char magic[4];
+  uint32_t version = 0, rate_bits = 0, run_count = 0;
+  uint64_t seed = 0;
+  bool ok = fread(magic, 1, 4, f) == 4 && memcmp(magic, REPLAY_MAGIC, 4) == 0 && read_u32(f, &version) &&
+      version == REPLAY_VERSION && read_u64(f, &seed) && read_u32(f, &rate_bits) && read_u32(f, &run_count);
+  // Count comes from the file: don't reserve more runs than the file holds
+  long left = ok ? bytes_left(f) : -1;
+  ok = ok && left >= 0 && (uint64_t)run_count * REPLAY_RUN_BYTES <= (uint64_t)left;
+
+  Replay *replay = NULL;
+  if (ok) {
+    float tick_rate;
+    memcpy(&tick_rate, &rate_bits, sizeof(tick_rate));
+    replay = replay_create(seed, tick_rate);
+    ok = replay && reserve_runs(replay, run_count);
+  }
+  for (uint32_t i = 0; ok && i < run_count; i++) {
+    InputRun run;
+    ok = read_u32(f, &run.ticks) && read_u64(f, &run.keys) && run.ticks > 0 &&
+        replay->tick_count <= UINT32_MAX - run.ticks;
+    if (!ok) break;
+    replay->runs[replay->run_count++] = run;
+    replay->tick_count += run.ticks;
+  }
+  fclose(f);
+
+  if (!ok) {
+    replay_free(replay);
+    return NULL;
+  }
+  return replay;
+}
@@ -0,0 +1,94 @@
+#include "slots_priv.h"
+#include <engine/memory.h>
+#include <engine/types.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool slot_table_init(SlotTable *table, uint32_t capacity) {
+  if (!table) return false;
+  *table = (SlotTable){0};
+  table->free_head = SLOT_INVALID;
+  return slot_table_grow(table, capacity);
+}
+
+void slot_table_free(SlotTable *table) {
+  if (!table) return;
+  memory_free(table->generations);
+  memory_free(table->dense);
+  memory_free(table->slots);
+  *table = (SlotTable){0};
+}
+
+static bool grow_array(uint32_t **array, uint32_t capacity) {
+  uint32_t *grown = memory_realloc(MEMORY_ENTITIES, *array, (size_t)capacity * sizeof(uint32_t));
+  if (!grown) return false;
+  *array = grown;
+  return true;
+}
+
+bool slot_table_grow(SlotTable *table, uint32_t capacity) {
+  if (!table) return false;
+  uint32_t old = table->capacity;
+  if (capacity <= old) return true;
+  // Slot index must fit into SLOT_INVALID and be distinguishable from it
+  if (capacity >= SLOT_INVALID) return false;
+
+  if (!grow_array(&table->generations, capacity) || !grow_array(&table->dense, capacity) ||
+      !grow_array(&table->slots, capacity))
+    return false;
+
+  // New slots start at generation 1 and are chained in order before the old free ones
+  for (uint32_t i = old; i < capacity; i++) {
+    table->generations[i] = 1;
+    table->dense[i] = i + 1 < capacity ? i + 1 : table->free_head;
+  }
+  table->free_head = old;
+  table->capacity = capacity;
+  return true;
+}
+
+Handle slot_table_add(SlotTable *table) {
+  if (!table || table->free_head == SLOT_INVALID) return HANDLE_NONE;
+
+  uint32_t slot = table->free_head;
+  table->free_head = table->dense[slot];
+
+  uint32_t index = table->count++;
+  table->dense[slot] = index;
+  table->slots[index] = slot;
+  return (Handle){slot, table->generations[slot]};
+}
+
+uint32_t slot_table_lookup(const SlotTable *table, Handle handle) {
+  if (!table || handle.index >= table->capacity) return SLOT_INVALID;
+  if (table->generations[handle.index] != handle.generation) return SLOT_INVALID;
+  // Freeing bumps the generation, so stale handles fail above. The slot is also checked to be alive,
+  // which only matters for handles of a wrapped-around generation or forged ones.
+  uint32_t index = table->dense[handle.index];
+  if (index >= table->count || table->slots[index] != handle.index) return SLOT_INVALID;
+  return index;
+}
+
+uint32_t slot_table_remove(SlotTable *table, Handle handle) {
+  uint32_t index = slot_table_lookup(table, handle);
+  if (index == SLOT_INVALID) return SLOT_INVALID;
+
+  // Last item takes place of the removed one
+  uint32_t last = --table->count;
+  uint32_t last_slot = table->slots[last];
+  table->slots[index] = last_slot;
+  table->dense[last_slot] = index;
+
+  // Generation 0 is reserved for invalid handles
+  uint32_t slot = handle.index;
+  if (++table->generations[slot] == 0) table->generations[slot] = 1;
+  table->dense[slot] = table->free_head;
+  table->free_head = slot;
+  return index;
+}
+
+Handle slot_table_handle(const SlotTable *table, uint32_t dense_index) {
+  if (!table || dense_index >= table->count) return HANDLE_NONE;
+  uint32_t slot = table->slots[dense_index];
+  return (Handle){slot, table->generations[slot]};
+}
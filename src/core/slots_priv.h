@@ -0,0 +1,38 @@
+#ifndef SLOTS_PRIV_H
+#define SLOTS_PRIV_H
+
+#include <engine/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Maps stable handles to indices of a densely packed array.
+//
+// Owners keep their items in [0, count) and move the last item into the hole on removal;
+// the table tracks where every item went. Lookup, add and remove are O(1).
+typedef struct SlotTable {
+  uint32_t *generations; // per slot, incremented when the slot is freed
+  uint32_t *dense;       // per slot: dense index if alive, next free slot otherwise
+  uint32_t *slots;       // per dense index: slot of the item
+  uint32_t count;        // alive items
+  uint32_t capacity;     // slots
+  uint32_t free_head;    // first free slot, SLOT_INVALID if none
+} SlotTable;
+
+#define SLOT_INVALID UINT32_MAX
+
+bool slot_table_init(SlotTable *table, uint32_t capacity);
+void slot_table_free(SlotTable *table);
+// Add slots up to 'capacity'. Handles and dense indices are not changed.
+bool slot_table_grow(SlotTable *table, uint32_t capacity);
+
+// Take a free slot for new item at dense index 'count'. Returns HANDLE_NONE if the table is full.
+Handle slot_table_add(SlotTable *table);
+// Dense index of the item or SLOT_INVALID if the handle is stale.
+uint32_t slot_table_lookup(const SlotTable *table, Handle handle);
+// Free slot of the item. The last item takes its dense index: the owner must move it from
+// 'count' (new value) to the returned index. Returns SLOT_INVALID if the handle is stale.
+uint32_t slot_table_remove(SlotTable *table, Handle handle);
+// Handle of the item at given dense index
+Handle slot_table_handle(const SlotTable *table, uint32_t dense_index);
+
+#endif
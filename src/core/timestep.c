@@ -0,0 +1,55 @@
+#include <engine/timestep.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+void tick_clock_init(TickClock *clock, float tick_rate) {
+  if (!clock) return;
+  *clock = (TickClock){0};
+  clock->max_ticks = TICK_DEFAULT_MAX_TICKS;
+  clock->policy = TICK_OVERRUN_SLOW_MOTION;
+  if (!tick_clock_set_rate(clock, tick_rate)) clock->step = 1.0f / 60.0f;
+}
+
+bool tick_clock_set_rate(TickClock *clock, float tick_rate) {
+  if (!clock || !(tick_rate > 0.0f)) return false;
+  float old_step = clock->step;
+  clock->step = 1.0f / tick_rate;
+  // Keep the same fraction of a step, so rendering interpolation doesn't jump
+  if (old_step > 0.0f) clock->accumulator *= clock->step / old_step;
+  return true;
+}
+
+uint32_t tick_clock_advance(TickClock *clock, float frame_time) {
+  if (!clock || clock->step <= 0.0f) return 0;
+  if (frame_time < 0.0f) frame_time = 0.0f;
+
+  uint32_t max_ticks = clock->max_ticks > 0 ? clock->max_ticks : 1;
+  float budget = clock->step * (float)max_ticks;
+  if (clock->policy == TICK_OVERRUN_SLOW_MOTION && frame_time > budget) {
+    frame_time = budget;
+    clock->stats.overrun_frames++;
+  }
+  clock->accumulator += frame_time;
+
+  uint64_t due = (uint64_t)(clock->accumulator / clock->step);
+  uint32_t run = due > max_ticks ? max_ticks : (uint32_t)due;
+  if (due > max_ticks && clock->policy != TICK_OVERRUN_SLOW_MOTION) {
+    clock->stats.overrun_frames++;
+    if (clock->policy == TICK_OVERRUN_DROP) {
+      clock->stats.skipped_ticks += due - max_ticks;
+      clock->accumulator -= (float)(due - max_ticks) * clock->step;
+    }
+  }
+
+  clock->accumulator -= (float)run * clock->step;
+  if (clock->accumulator < 0.0f) clock->accumulator = 0.0f; // float rounding
+  clock->stats.ticks += run;
+  if (run > 1) clock->stats.late_ticks += run - 1;
+  return run;
+}
+
+float tick_clock_alpha(const TickClock *clock) {
+  if (!clock || clock->step <= 0.0f) return 0.0f;
+  float alpha = clock->accumulator / clock->step;
+  return alpha > 1.0f ? 1.0f : alpha;
+}
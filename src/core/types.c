@@ -1,6 +1,7 @@
 #include "stb_image.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <engine/memory.h>
 #include <engine/types.h>
 #include <math.h>
 #include <stdint.h>
@@ -29,7 +30,7 @@ static Sprite load_and_scale_region(const unsigned char *data,
 
   sprite.width = scaled_width;
   sprite.height = scaled_height;
-  sprite.pixels = (uint32_t *)calloc(scaled_width * scaled_height, sizeof(uint32_t));
+  sprite.pixels = memory_calloc(MEMORY_SPRITES, (size_t)scaled_width * scaled_height, sizeof(uint32_t));
 
   if (!sprite.pixels) {
     sprite.width = sprite.height = 0;
@@ -79,7 +80,7 @@ Sprite load_sprite(const char *path, float scale) {
 
 void free_sprite(Sprite *sprite) {
   if (!sprite) return;
-  if (sprite->pixels) { free(sprite->pixels); }
+  memory_free(sprite->pixels);
 }
 
 // Load spritesheet and split into individual frames (sprites)
@@ -149,7 +150,7 @@ Sprite text_sprite(const char *text, TTF_Font *font, SDL_Color color) {
   sprite.width = (uint32_t)src->w;
   sprite.height = (uint32_t)src->h;
   size_t row_bytes = (size_t)sprite.width * sizeof(uint32_t);
-  sprite.pixels = (uint32_t *)calloc((size_t)sprite.width * sprite.height, sizeof(uint32_t));
+  sprite.pixels = memory_calloc(MEMORY_TEXT, (size_t)sprite.width * sprite.height, sizeof(uint32_t));
   if (!sprite.pixels) {
     sprite.width = sprite.height = 0;
     SDL_FreeSurface(src);
@@ -13,3 +13,25 @@ inline uint32_t alpha_blend(uint32_t top, uint32_t bot) {
   uint32_t g = (((top & 0x0000FF00) * top_a + (bot & 0x0000FF00) * inv_a) >> 8) & 0x0000FF00;
   return 0xFF000000 | rb | g;
 }
+
+// Accepts ARGB top and bot colors, where bot may be transparent (e.g. cached overlay).
+// Returns ARGB color that looks like top drawn over bot when blended onto anything.
+uint32_t alpha_over(uint32_t top, uint32_t bot) {
+  uint32_t top_a = (top >> 24);
+  uint32_t bot_a = (bot >> 24);
+  if (top_a == 0) return bot;
+  if (top_a == 255 || bot_a == 0) return top;
+
+  // Bottom color weight: bot_a * (1 - top_a), scaled by 255 * 255
+  uint32_t bot_w = bot_a * (255 - top_a);
+  uint32_t top_w = top_a * 255;
+  uint32_t out_w = top_w + bot_w;
+
+  uint32_t out = ((out_w + 127) / 255) << 24;
+  for (int shift = 0; shift < 24; shift += 8) {
+    uint32_t t = (top >> shift) & 0xFF;
+    uint32_t b = (bot >> shift) & 0xFF;
+    out |= ((t * top_w + b * bot_w + out_w / 2) / out_w) << shift;
+  }
+  return out;
+}
@@ -4,5 +4,6 @@
 #include <stdint.h>
 
 uint32_t alpha_blend(uint32_t src, uint32_t dst);
+uint32_t alpha_over(uint32_t src, uint32_t dst);
 
 #endif
@@ -0,0 +1,124 @@
+#include <engine/animation.h>
+#include <engine/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Frames of clips with zero frame time are never changed
+#define ANIM_NEVER_MS 0x7FFFFFFFu
+
+struct Animator {
+  AnimSet *sets;
+  uint16_t set_count;
+  uint16_t set_capacity;
+  uint32_t now_ms; // Animation clock, wraps around
+  float ms_remainder;
+};
+
+Animator *animator_create(void) {
+  return calloc(1, sizeof(Animator));
+}
+
+void animator_free(Animator *an) {
+  if (!an) return;
+  free(an->sets);
+  free(an);
+}
+
+uint16_t animator_add_set(Animator *an, AnimSet set) {
+  if (!an || an->set_count >= ANIM_MAX_SETS) return ANIM_SET_NONE;
+  if (an->set_count == an->set_capacity) {
+    uint32_t capacity = an->set_capacity ? (uint32_t)an->set_capacity * 2 : 4;
+    if (capacity > ANIM_MAX_SETS) capacity = ANIM_MAX_SETS;
+    AnimSet *sets = realloc(an->sets, capacity * sizeof(AnimSet));
+    if (!sets) return ANIM_SET_NONE;
+    an->sets = sets;
+    an->set_capacity = (uint16_t)capacity;
+  }
+  an->sets[an->set_count] = set;
+  return an->set_count++;
+}
+
+// Time is compared with wrap-around, like TCP sequence numbers
+static inline bool time_reached(uint32_t now, uint32_t t) {
+  return (int32_t)(now - t) >= 0;
+}
+
+static inline uint32_t frame_delay(const AnimClip *clip) {
+  return clip->frame_ms ? clip->frame_ms : ANIM_NEVER_MS;
+}
+
+static void switch_clip(const Animator *an, EntityAnim *anim, Sprite **sprite, uint16_t clip) {
+  const AnimSet *set = &an->sets[anim->set];
+  anim->clip = clip;
+  anim->frame = 0;
+  anim->next_frame_ms = an->now_ms + frame_delay(&set->clips[clip]);
+  if (sprite) *sprite = &set->frames[set->clips[clip].start];
+}
+
+void animator_start(const Animator *an, EntityAnim *anim, Sprite **sprite, uint16_t set) {
+  if (!an || !anim || set >= an->set_count || an->sets[set].clip_count == 0) return;
+  anim->set = set;
+  anim->state = 0;
+  switch_clip(an, anim, sprite, 0);
+}
+
+void animator_play(const Animator *an, EntityAnim *anim, Sprite **sprite, uint16_t clip) {
+  if (!an || !anim || anim->set >= an->set_count) return;
+  if (clip >= an->sets[anim->set].clip_count || clip == anim->clip) return;
+  switch_clip(an, anim, sprite, clip);
+}
+
+void animator_set_state(
+    const Animator *an, EntityAnim *anim, Sprite **sprite, uint16_t state, uint16_t variant) {
+  if (!an || !anim || anim->set >= an->set_count) return;
+  const AnimSet *set = &an->sets[anim->set];
+  if (!set->state_clips || state >= set->state_count || variant >= set->variant_count) return;
+
+  anim->state = state;
+  animator_play(an, anim, sprite, set->state_clips[state * set->variant_count + variant]);
+}
+
+void animator_tick(Animator *an, float delta_time) {
+  if (!an || delta_time <= 0.0f) return;
+
+  // Keep fractions of millisecond, so clock doesn't drift with 1/60 s steps
+  float ms = delta_time * 1000.0f + an->ms_remainder;
+  uint32_t whole = (uint32_t)ms;
+  an->ms_remainder = ms - (float)whole;
+  an->now_ms += whole;
+}
+
+void animator_advance(const Animator *an, EntityAnim *anims, Sprite **sprites, uint32_t count) {
+  if (!an || !anims || !sprites) return;
+  uint32_t now = an->now_ms;
+
+  for (uint32_t i = 0; i < count; i++) {
+    EntityAnim *anim = &anims[i];
+    if (!time_reached(now, anim->next_frame_ms)) continue;
+    if (anim->set >= an->set_count) continue;
+
+    const AnimSet *set = &an->sets[anim->set];
+    const AnimClip *clip = &set->clips[anim->clip];
+    if (clip->count == 0) continue;
+
+    // Usually one step, more if the logic step is longer than frame time
+    for (uint32_t steps = 0; time_reached(now, anim->next_frame_ms); steps++) {
+      if (steps > clip->count) {
+        // Too far behind (e.g. after a stall): don't replay missed frames
+        anim->next_frame_ms = now + frame_delay(clip);
+        break;
+      }
+      if (++anim->frame >= clip->count) {
+        anim->frame = 0;
+        if (clip->next != anim->clip && clip->next < set->clip_count) {
+          anim->clip = clip->next;
+          clip = &set->clips[anim->clip];
+        }
+      }
+      anim->next_frame_ms += frame_delay(clip);
+    }
+
+    sprites[i] = &set->frames[clip->start + anim->frame];
+  }
+}
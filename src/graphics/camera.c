@@ -6,6 +6,7 @@ Camera *camera_create(float width, float height) {
   if (!camera) { return NULL; }
 
   camera->size = (Vector){width, height};
+  camera->zoom = 1.0f;
   camera->position = (Vector){0.0f, 0.0f};
   camera->target = (Vector){0.0f, 0.0f};
   camera->follow_speed = 8.0f; // not used yet
@@ -19,16 +20,25 @@ void camera_free(Camera *camera) {
   if (camera) { free(camera); }
 }
 
+// Center camera on target immediately, without interpolation from the old position
+void camera_snap(Camera *camera) {
+  if (!camera) return;
+  camera->position.x = camera->target.x - camera->size.x / (2.0f * camera->zoom);
+  camera->position.y = camera->target.y - camera->size.y / (2.0f * camera->zoom);
+  camera->prev_position = camera->position;
+}
+
 // Smoothly update camera position to follow target
 // At every call (camera_update), the camera moves a fraction of the distance
 void camera_update(Camera *camera, float delta_time) {
   if (!camera) return;
+  camera->prev_position = camera->position;
 
   if (camera->following) {
     // We want to camera position (top-left corner) be shifted by half size from target
     Vector desired;
-    desired.x = camera->target.x - camera->size.x / 2.0f;
-    desired.y = camera->target.y - camera->size.y / 2.0f;
+    desired.x = camera->target.x - camera->size.x / (2.0f * camera->zoom);
+    desired.y = camera->target.y - camera->size.y / (2.0f * camera->zoom);
 
     // Smoothly follow the target
     Vector diff;
@@ -43,6 +53,26 @@ void camera_update(Camera *camera, float delta_time) {
   }
 }
 
+void camera_set_zoom(Camera *camera, float zoom) {
+  if (!camera || zoom <= 0.0f) return;
+
+  // Shift of top-left corner that keeps the center in place
+  float dx = camera->size.x / (2.0f * camera->zoom) - camera->size.x / (2.0f * zoom);
+  float dy = camera->size.y / (2.0f * camera->zoom) - camera->size.y / (2.0f * zoom);
+  camera->position.x += dx;
+  camera->position.y += dy;
+  camera->prev_position.x += dx;
+  camera->prev_position.y += dy;
+  camera->zoom = zoom;
+}
+
+Camera camera_interpolate(const Camera *camera, float alpha) {
+  Camera view = *camera;
+  view.position.x = camera->prev_position.x + (camera->position.x - camera->prev_position.x) * alpha;
+  view.position.y = camera->prev_position.y + (camera->position.y - camera->prev_position.y) * alpha;
+  return view;
+}
+
 // Check if a world position is visible in the camera
 bool camera_is_visible(const Camera *camera, Vector pos) {
   if (!camera) return false;
@@ -55,8 +85,8 @@ Vector camera_world_to_screen(const Camera *camera, Vector world_pos) {
   if (!camera) return world_pos;
 
   Vector screen;
-  screen.x = world_pos.x - camera->position.x;
-  screen.y = world_pos.y - camera->position.y;
+  screen.x = (world_pos.x - camera->position.x) * camera->zoom;
+  screen.y = (world_pos.y - camera->position.y) * camera->zoom;
   return screen;
 }
 
@@ -65,7 +95,7 @@ Vector camera_screen_to_world(const Camera *camera, Vector screen_pos) {
   if (!camera) return screen_pos;
 
   Vector world;
-  world.x = screen_pos.x + camera->position.x;
-  world.y = screen_pos.y + camera->position.y;
+  world.x = screen_pos.x / camera->zoom + camera->position.x;
+  world.y = screen_pos.y / camera->zoom + camera->position.y;
   return world;
 }
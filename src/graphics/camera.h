@@ -4,8 +4,10 @@
 #include <engine/types.h>
 
 typedef struct Camera {
-  Vector position; // top-left corner in world coordinates
-  Vector size;
+  Vector position;      // top-left corner in world coordinates
+  Vector prev_position; // position before the last camera_update, for interpolation
+  Vector size;          // viewport size in screen pixels
+  float zoom;           // screen pixels per world pixel, visible world area is size / zoom
   Vector target;
   Vector world_bounds;
   float follow_speed;
@@ -15,6 +17,11 @@ typedef struct Camera {
 Camera *camera_create(float width, float height);
 void camera_free(Camera *camera);
 void camera_update(Camera *camera, float delta_time);
+void camera_snap(Camera *camera);
+// Change zoom keeping the world point in the middle of the screen in place
+void camera_set_zoom(Camera *camera, float zoom);
+// Camera state between previous and current update. 'alpha' is in [0, 1].
+Camera camera_interpolate(const Camera *camera, float alpha);
 
 bool camera_is_visible(const Camera *camera, Vector pos);
 
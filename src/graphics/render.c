@@ -1,8 +1,12 @@
 #include "render.h"
 #include "camera.h"
 #include "graphics/alpha_blend.h"
+#include "graphics/render_list_priv.h"
+#include "graphics/scale.h"
+#include "graphics/ui_priv.h"
 #include "world/map_priv.h"
 #include <engine/coordinates.h>
+#include <engine/entity.h>
 #include <engine/types.h>
 #include <math.h>
 #include <stdlib.h>
@@ -10,13 +14,9 @@
 
 // Compare two game objects by their depth (y-coordinate + height)
 static int compare_objs_by_depth(const void *a, const void *b) {
-  const GameObject *obj_a = *(const GameObject **)a;
-  const GameObject *obj_b = *(const GameObject **)b;
-
   // Sort by bottom edge of sprite for proper isometric depth
-  float ya = obj_a->position.y + (obj_a->cur_sprite ? obj_a->cur_sprite->height : 0);
-  float yb = obj_b->position.y + (obj_b->cur_sprite ? obj_b->cur_sprite->height : 0);
-
+  float ya = object_depth(*(const GameObject **)a);
+  float yb = object_depth(*(const GameObject **)b);
   return (ya > yb) - (ya < yb);
 }
 
@@ -27,35 +27,43 @@ static int compare_ui_by_z(const void *a, const void *b) {
   return (ui_a->z_index > ui_b->z_index) - (ui_a->z_index < ui_b->z_index);
 }
 
-// Render shadow for given object onto framebuffer
-static void render_shadow(uint32_t *framebuffer, Camera *camera, GameObject *obj) {
+void render_shadow(uint32_t *framebuffer, Camera *camera, GameObject *obj, Vector world_pos) {
   if (!framebuffer || !obj || !obj->cur_sprite) return;
 
   // top-left corner of the object in screen coordinates
-  Vector top_left = camera_world_to_screen(camera, obj->position);
+  Vector top_left = camera_world_to_screen(camera, world_pos);
   int sprite_w = obj->cur_sprite->width;
   int sprite_h = obj->cur_sprite->height;
+  int shadow_w = (int)scaled_size(sprite_w, camera->zoom);
+  int shadow_h = (int)scaled_size(sprite_h, camera->zoom);
   int32_t cam_w = (uint32_t)camera->size.x;
   int32_t cam_h = (uint32_t)camera->size.y;
 
   uint32_t shadow_color = 100 << 24;
-  float x_shift_scale = 0.4f;
+  float x_shift_scale = SHADOW_SKEW;
   // do nothing if shadow is out of the screen
-  if (!is_rect_intersect((Rect){top_left, sprite_w + sprite_h * (1.0f + x_shift_scale), sprite_h},
+  if (!is_rect_intersect((Rect){top_left, shadow_w + shadow_h * (1.0f + x_shift_scale), shadow_h},
           (Rect){(Vector){0.0f, 0.0f}, cam_w, cam_h})) {
     return;
   }
 
-  for (int y = 0; y < sprite_h; y++) {
-    float x_shift = (sprite_h - y) * x_shift_scale;
+  // Screen pixels are mapped back to sprite pixels in 16.16 fixed point, so zoom costs nothing extra
+  uint32_t step = (uint32_t)lroundf((float)SCALE_FP_ONE / camera->zoom);
+  for (int y = 0; y < shadow_h; y++) {
+    int sy = (int)(((uint64_t)y * step) >> SCALE_FP_SHIFT);
+    if (sy >= sprite_h) sy = sprite_h - 1;
+    float x_shift = (sprite_h - sy) * x_shift_scale * camera->zoom;
     int32_t shad_y = top_left.y + y;
     if (shad_y < 0 || shad_y >= cam_h) { continue; }
 
-    for (int x = 0; x < sprite_w; x++) {
+    const uint32_t *row = obj->cur_sprite->pixels + sy * sprite_w;
+    for (int x = 0; x < shadow_w; x++) {
       int32_t shad_x = top_left.x + x + x_shift;
       if (shad_x < 0 || shad_x >= cam_w) { continue; }
 
-      uint32_t pix = obj->cur_sprite->pixels[y * sprite_w + x];
+      int sx = (int)(((uint64_t)x * step) >> SCALE_FP_SHIFT);
+      if (sx >= sprite_w) sx = sprite_w - 1;
+      uint32_t pix = row[sx];
       if (((pix >> 24) & 0xFF) == 0) continue; // if pixel is transparent (alpha == 0), skip
       uint32_t fb_idx = shad_y * cam_w + shad_x;
       framebuffer[fb_idx] = alpha_blend(shadow_color, framebuffer[fb_idx]);
@@ -63,92 +71,179 @@ static void render_shadow(uint32_t *framebuffer, Camera *camera, GameObject *obj
   }
 }
 
-static void render_sprite(uint32_t *framebuffer, Sprite *sprite, Vector screen_pos, Camera *camera) {
+// Render sprite scaled by 'zoom' with top-left corner at given screen position
+static void render_sprite(uint32_t *framebuffer,
+    const Sprite *sprite,
+    Vector screen_pos,
+    Camera *camera,
+    float zoom) {
   if (!framebuffer || !sprite || !camera) return;
 
-  // Return if sprite is completely off-screen
-  if (!is_rect_intersect((Rect){screen_pos, sprite->width, sprite->height},
-          (Rect){(Vector){0.0f, 0.0f}, camera->size.x, camera->size.y})) {
-    return;
-  }
-
-  for (uint32_t sy = 0; sy < sprite->height; sy++) {
-    int screen_y = screen_pos.y + sy;
-    if (screen_y < 0 || screen_y >= camera->size.y) { continue; }
-
-    for (uint32_t sx = 0; sx < sprite->width; sx++) {
-      int screen_x = screen_pos.x + sx;
-      if (screen_x < 0 || screen_x >= camera->size.x) { continue; }
-
-      uint32_t src = sprite->pixels[sy * sprite->width + sx];
-      int fb_idx = screen_y * camera->size.x + screen_x;
-      uint32_t dst = framebuffer[fb_idx];
-      framebuffer[fb_idx] = alpha_blend(src, dst);
-    }
-  }
+  blit_scaled(framebuffer,
+      (uint32_t)camera->size.x,
+      (uint32_t)camera->size.y,
+      sprite,
+      (int)floorf(screen_pos.x),
+      (int)floorf(screen_pos.y),
+      zoom);
 }
 
 // Render given game object onto framebuffer considering camera position
-static void render_object(uint32_t *framebuffer, GameObject *object, Camera *camera) {
+static void render_object(uint32_t *framebuffer, GameObject *object, Camera *camera, float alpha) {
   if (!framebuffer || !object || !object->cur_sprite) return;
   Sprite *sprite = object->cur_sprite;
+  Vector world_pos = object_draw_position(object, alpha);
 
   // Render shadow first
-  render_shadow(framebuffer, camera, object);
+  render_shadow(framebuffer, camera, object, world_pos);
 
-  Vector obj_screen = camera_world_to_screen(camera, object->position);
-  render_sprite(framebuffer, sprite, obj_screen, camera);
+  Vector obj_screen = camera_world_to_screen(camera, world_pos);
+  render_sprite(framebuffer, sprite, obj_screen, camera, camera->zoom);
 }
 
-static void render_ui_element(uint32_t *framebuffer, UIElement *ui, Camera *camera) {
+static void render_ui_element(uint32_t *framebuffer, UIElement *ui, Camera *camera, float alpha) {
   if (!framebuffer || !ui || !ui->sprite) return;
 
   Vector screen_pos;
   if (ui->mode == UI_POS_SCREEN) {
     screen_pos = ui->position.screen;
   } else if (ui->mode == UI_POS_ATTACHED) {
-    Vector obj_screen_pos = camera_world_to_screen(camera, ui->position.attached.object->position);
+    Vector obj_pos = object_draw_position(ui->position.attached.object, alpha);
+    Vector obj_screen_pos = camera_world_to_screen(camera, obj_pos);
     screen_pos.x = obj_screen_pos.x + ui->position.attached.offset.x;
     screen_pos.y = obj_screen_pos.y + ui->position.attached.offset.y;
   } else {
     return; // Unknown mode
   }
 
-  render_sprite(framebuffer, ui->sprite, screen_pos, camera);
+  // UI is drawn in screen pixels, it is not zoomed
+  render_sprite(framebuffer, ui->sprite, screen_pos, camera, 1.0f);
 }
 
-void render_batch(uint32_t *framebuffer, RenderBatch *batch, Camera *camera) {
+void render_batch(uint32_t *framebuffer, RenderBatch *batch, Camera *camera, float alpha) {
   if (!framebuffer || !batch || !camera) return;
 
-  if (batch->objs != NULL) {
-    qsort(batch->objs, batch->obj_count, sizeof(GameObject *), compare_objs_by_depth);
-    for (uint32_t i = 0; i < batch->obj_count; i++) { render_object(framebuffer, batch->objs[i], camera); }
+  // Single view: same path as engine views, with temporary memory
+  Arena *arena = arena_create(0);
+  RenderShared shared = {0};
+  if (render_prepare_objects(&shared, batch, arena, alpha)) {
+    render_view_objects(framebuffer, batch, &shared, camera, alpha);
   }
+  arena_free(arena);
 
-  if (batch->uis == NULL) return;
-  qsort(batch->uis, batch->ui_count, sizeof(UIElement *), compare_ui_by_z);
-  for (uint32_t i = 0; i < batch->ui_count; i++) { render_ui_element(framebuffer, batch->uis[i], camera); }
+  render_batch_ui(framebuffer, batch, camera, alpha);
 }
 
-void load_prerendered(uint32_t *framebuffer, Map *map, Camera *camera) {
-  if (!map || !framebuffer || !camera) return;
+void render_batch_ui(uint32_t *framebuffer, RenderBatch *batch, Camera *camera, float alpha) {
+  if (!framebuffer || !batch || !camera) return;
 
-  Vector top_left_world = camera_screen_to_world(camera, (Vector){0, 0});
-  int map_start_x = (int)top_left_world.x;
-  int map_start_y = (int)top_left_world.y;
+  if (batch->uis != NULL) {
+    qsort(batch->uis, batch->ui_count, sizeof(UIElement *), compare_ui_by_z);
+    for (uint32_t i = 0; i < batch->ui_count; i++) {
+      render_ui_element(framebuffer, batch->uis[i], camera, alpha);
+    }
+  }
 
-  // Render visible part of the map
-  for (uint32_t screen_y = 0; screen_y < camera->size.y; screen_y++) {
-    uint32_t map_y = map_start_y + screen_y;
-    if (map_y >= map->height_pix) { continue; }
+  render_ui_layer(framebuffer, batch->ui_layer, camera, alpha);
+}
 
-    for (uint32_t screen_x = 0; screen_x < camera->size.x; screen_x++) {
-      uint32_t map_x = map_start_x + screen_x;
-      if (map_x >= map->width_pix) { continue; }
+bool render_prepare_objects(RenderShared *shared, RenderBatch *batch, Arena *arena, float alpha) {
+  if (!shared || !batch || !arena) return false;
+  shared->count = 0;
+  RenderList *list = batch->render_list;
+  if (list && !render_list_prepare(list)) return false;
+
+  // Objects that may move: batch objects, entities and dynamic part of the render list
+  uint32_t obj_count = batch->objs ? batch->obj_count : 0;
+  uint32_t entity_count = batch->entities ? batch->entities->count : 0;
+  uint32_t list_count = list ? object_pool_count(list->dynamic) : 0;
+  uint32_t dyn_count = obj_count + entity_count + list_count;
+  uint32_t static_count = list ? list->sorted_count : 0;
+  uint32_t count = dyn_count + static_count;
+  if (count == 0) return true;
+
+  // One extra element, as the arena returns NULL for empty allocations
+  GameObject **dyn = arena_alloc(arena, (dyn_count + 1) * sizeof(GameObject *));
+  shared->objs = arena_alloc(arena, count * sizeof(GameObject *));
+  shared->bounds = arena_alloc(arena, count * sizeof(Rect));
+  if (!dyn || !shared->objs || !shared->bounds) return false;
+  if (obj_count > 0) memcpy(dyn, batch->objs, obj_count * sizeof(GameObject *));
+  for (uint32_t i = 0; i < entity_count; i++) {
+    dyn[obj_count + i] = entity_store_object_at(batch->entities, i);
+  }
+  if (list_count > 0) {
+    GameObject **list_objs = OBJECT_POOL_ITEMS(list->dynamic, GameObject *);
+    memcpy(dyn + obj_count + entity_count, list_objs, list_count * sizeof(GameObject *));
+  }
+  qsort(dyn, dyn_count, sizeof(GameObject *), compare_objs_by_depth);
+
+  // Merge sorted dynamic objects with presorted static ones. Static bounds are precomputed.
+  uint32_t d = 0, s = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    if (s < static_count && (d == dyn_count || list->depths[s] <= object_depth(dyn[d]))) {
+      shared->objs[i] = list->sorted[s];
+      shared->bounds[i] = list->bounds[s++];
+    } else {
+      const GameObject *obj = dyn[d];
+      shared->objs[i] = dyn[d++];
+      shared->bounds[i] = object_bounds(obj, object_draw_position(obj, alpha));
+    }
+  }
+  shared->count = count;
+  return true;
+}
 
-      int idx = screen_y * (int)camera->size.x + screen_x;
-      uint32_t pixel = map->pixels[map_y * map->width_pix + map_x];
-      framebuffer[idx] = alpha_blend(pixel, framebuffer[idx]);
+void render_view_objects(uint32_t *framebuffer,
+    const RenderBatch *batch,
+    const RenderShared *shared,
+    Camera *camera,
+    float alpha) {
+  if (!framebuffer || !batch || !shared || !camera) return;
+
+  Rect visible = {camera->position, camera->size.x / camera->zoom, camera->size.y / camera->zoom};
+  for (uint32_t i = 0; i < shared->count; i++) {
+    if (!is_rect_intersect(shared->bounds[i], visible)) continue;
+    render_object(framebuffer, shared->objs[i], camera, alpha);
+  }
+}
+
+// Blend cached overlay of screen-space elements onto framebuffer
+static void render_ui_segment(uint32_t *framebuffer, const UISegment *seg, Camera *camera) {
+  uint32_t fb_width = (uint32_t)camera->size.x;
+  for (uint32_t y = 0; y < seg->height; y++) {
+    const uint32_t *src = seg->pixels + (size_t)y * seg->width;
+    uint32_t *dst = framebuffer + (size_t)(seg->y + y) * fb_width + seg->x;
+    for (uint32_t x = 0; x < seg->width; x++) { dst[x] = alpha_blend(src[x], dst[x]); }
+  }
+}
+
+void render_ui_layer(uint32_t *framebuffer, UILayer *layer, Camera *camera, float alpha) {
+  if (!framebuffer || !layer || !camera) return;
+  ui_layer_prepare(layer, (uint32_t)camera->size.x, (uint32_t)camera->size.y);
+
+  uint32_t i = 0;
+  while (i < layer->count) {
+    const UIEntry *entry = &layer->entries[i];
+    if (entry->segment < 0) {
+      render_ui_element(framebuffer, entry->ui, camera, alpha);
+      i++;
+      continue;
     }
+    const UISegment *seg = &layer->segments[entry->segment];
+    render_ui_segment(framebuffer, seg, camera);
+    i = seg->first + seg->count;
   }
 }
+
+void load_prerendered(uint32_t *framebuffer, Map *map, Camera *camera) {
+  if (!map || !framebuffer || !camera) return;
+
+  // Prerendered map is one big sprite with top-left corner at world origin.
+  // Only its visible part is touched. When zoomed out, it is sampled from a smaller mip level,
+  // so neighbouring screen pixels read neighbouring memory and average the skipped pixels.
+  float level_zoom = camera->zoom;
+  Sprite full = {map->pixels, map->width_pix, map->height_pix};
+  const Sprite *level = map->mip_count > 0 ? map_mip_for_zoom(map, camera->zoom, &level_zoom) : &full;
+  Vector origin = camera_world_to_screen(camera, (Vector){0.0f, 0.0f});
+  render_sprite(framebuffer, level, origin, camera, level_zoom);
+}
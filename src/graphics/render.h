@@ -3,12 +3,54 @@
 
 #include "camera.h"
 #include "world/map_priv.h"
+#include <engine/alloc.h>
 #include <engine/types.h>
+#include <engine/ui.h>
 #include <stdbool.h>
 #include <stdint.h>
 
 // Load prerendered part of the map into framebuffer based on camera position
 void load_prerendered(uint32_t *framebuffer, Map *map, Camera *camera);
-void render_batch(uint32_t *framebuffer, RenderBatch *batch, Camera *camera);
+// Render objects and UI elements of the batch.
+// 'alpha' is a fraction of logic step passed since the last update, used to interpolate object positions.
+void render_batch(uint32_t *framebuffer, RenderBatch *batch, Camera *camera, float alpha);
+// Render only UI elements of the batch ('uis' and 'ui_layer').
+void render_batch_ui(uint32_t *framebuffer, RenderBatch *batch, Camera *camera, float alpha);
+
+// Data shared by all views of a frame: objects are depth-sorted once and their world bounds
+// (sprite with shadow, at interpolated position) are computed once, so every view only tests
+// bounds against its visible rect.
+typedef struct {
+  GameObject **objs; // all objects of the batch, sorted by depth
+  Rect *bounds;      // bounds[i] belongs to objs[i]
+  uint32_t count;
+} RenderShared;
+
+// Collect batch objects, entities and render list objects in depth order and fill shared data.
+// Arrays are allocated from 'arena' and live until it is reset. Returns false on allocation failure.
+bool render_prepare_objects(RenderShared *shared, RenderBatch *batch, Arena *arena, float alpha);
+// Render objects visible by 'camera'. Only reads batch and shared data, so different views
+// can be rendered in parallel into different framebuffers.
+void render_view_objects(uint32_t *framebuffer,
+    const RenderBatch *batch,
+    const RenderShared *shared,
+    Camera *camera,
+    float alpha);
+
+// Position to draw object at: between previous and current logic step positions, by 'alpha' in [0, 1].
+// Objects without 'interpolate' are drawn at their current position.
+static inline Vector object_draw_position(const GameObject *obj, float alpha) {
+  if (!obj->interpolate) return obj->position;
+  Vector pos;
+  pos.x = obj->prev_position.x + (obj->position.x - obj->prev_position.x) * alpha;
+  pos.y = obj->prev_position.y + (obj->position.y - obj->prev_position.y) * alpha;
+  return pos;
+}
+
+// Render skewed shadow of 'obj' with its sprite at 'world_pos' onto framebuffer.
+void render_shadow(uint32_t *framebuffer, Camera *camera, GameObject *obj, Vector world_pos);
+
+// Render retained UI layer: cached overlays and elements attached to objects, in z order.
+void render_ui_layer(uint32_t *framebuffer, UILayer *layer, Camera *camera, float alpha);
 
 #endif
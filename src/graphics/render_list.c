@@ -0,0 +1,110 @@
+#include "graphics/render_list_priv.h"
+#include <engine/memory.h>
+#include <engine/object_pool.h>
+#include <engine/render_list.h>
+#include <engine/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define RENDER_LIST_INITIAL_CAPACITY 64
+
+RenderList *render_list_create(void) {
+  RenderList *list = calloc(1, sizeof(RenderList));
+  if (!list) return NULL;
+  list->dynamic = OBJECT_POOL_CREATE(GameObject *, RENDER_LIST_INITIAL_CAPACITY);
+  list->statics = OBJECT_POOL_CREATE(GameObject *, RENDER_LIST_INITIAL_CAPACITY);
+  if (!list->dynamic || !list->statics) {
+    render_list_free(list);
+    return NULL;
+  }
+  return list;
+}
+
+void render_list_free(RenderList *list) {
+  if (!list) return;
+  object_pool_free(list->dynamic);
+  object_pool_free(list->statics);
+  memory_free(list->sorted);
+  memory_free(list->depths);
+  memory_free(list->bounds);
+  free(list);
+}
+
+static Handle add_to_pool(ObjectPool *pool, GameObject *obj) {
+  GameObject **slot = NULL;
+  Handle handle = object_pool_alloc(pool, (void **)&slot);
+  if (slot) *slot = obj;
+  return handle;
+}
+
+Handle render_list_add(RenderList *list, GameObject *obj) {
+  if (!list || !obj) return HANDLE_NONE;
+  return add_to_pool(list->dynamic, obj);
+}
+
+Handle render_list_add_static(RenderList *list, GameObject *obj) {
+  if (!list || !obj) return HANDLE_NONE;
+  Handle handle = add_to_pool(list->statics, obj);
+  if (handle.generation != 0) list->static_dirty = true;
+  return handle;
+}
+
+void render_list_remove(RenderList *list, Handle handle) {
+  if (!list) return;
+  object_pool_release(list->dynamic, handle);
+}
+
+void render_list_remove_static(RenderList *list, Handle handle) {
+  if (!list) return;
+  if (object_pool_release(list->statics, handle)) list->static_dirty = true;
+}
+
+void render_list_invalidate_static(RenderList *list) {
+  if (list) list->static_dirty = true;
+}
+
+uint32_t render_list_count(const RenderList *list) {
+  if (!list) return 0;
+  return object_pool_count(list->dynamic) + object_pool_count(list->statics);
+}
+
+static int compare_objs_by_depth(const void *a, const void *b) {
+  float da = object_depth(*(const GameObject **)a);
+  float db = object_depth(*(const GameObject **)b);
+  return (da > db) - (da < db);
+}
+
+static bool reserve_sorted(RenderList *list, uint32_t count) {
+  if (count <= list->sorted_capacity) return true;
+  GameObject **sorted = memory_realloc(MEMORY_ENTITIES, list->sorted, count * sizeof(GameObject *));
+  if (sorted) list->sorted = sorted;
+  float *depths = memory_realloc(MEMORY_ENTITIES, list->depths, count * sizeof(float));
+  if (depths) list->depths = depths;
+  Rect *bounds = memory_realloc(MEMORY_ENTITIES, list->bounds, count * sizeof(Rect));
+  if (bounds) list->bounds = bounds;
+  if (!sorted || !depths || !bounds) return false;
+  list->sorted_capacity = count;
+  return true;
+}
+
+bool render_list_prepare(RenderList *list) {
+  if (!list) return false;
+  if (!list->static_dirty) return true;
+
+  uint32_t count = object_pool_count(list->statics);
+  if (!reserve_sorted(list, count)) return false;
+
+  GameObject **objs = OBJECT_POOL_ITEMS(list->statics, GameObject *);
+  for (uint32_t i = 0; i < count; i++) list->sorted[i] = objs[i];
+  qsort(list->sorted, count, sizeof(GameObject *), compare_objs_by_depth);
+  for (uint32_t i = 0; i < count; i++) {
+    const GameObject *obj = list->sorted[i];
+    list->depths[i] = object_depth(obj);
+    list->bounds[i] = object_bounds(obj, obj->position);
+  }
+
+  list->sorted_count = count;
+  list->static_dirty = false;
+  return true;
+}
@@ -0,0 +1,44 @@
+#ifndef RENDER_LIST_PRIV_H
+#define RENDER_LIST_PRIV_H
+
+#include <engine/object_pool.h>
+#include <engine/render_list.h>
+#include <engine/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Shadow is skewed to the right by that part of sprite height
+#define SHADOW_SKEW 0.4f
+
+struct RenderList {
+  ObjectPool *dynamic; // GameObject *
+  ObjectPool *statics; // GameObject *, in order of registration
+
+  // Static objects sorted by depth with precomputed depth and bounds, rebuilt when dirty
+  GameObject **sorted;
+  float *depths;
+  Rect *bounds;
+  uint32_t sorted_count;
+  uint32_t sorted_capacity;
+  bool static_dirty;
+};
+
+// Depth of object for draw order: bottom edge of its sprite
+static inline float object_depth(const GameObject *obj) {
+  return obj->position.y + (obj->cur_sprite ? obj->cur_sprite->height : 0);
+}
+
+// World area touched by object drawn at 'pos': sprite with its shadow
+static inline Rect object_bounds(const GameObject *obj, Vector pos) {
+  Rect b = {pos, 0.0f, 0.0f};
+  if (!obj->cur_sprite) return b;
+  // Shadow is skewed to the right by up to SHADOW_SKEW of sprite height
+  b.h = (float)obj->cur_sprite->height;
+  b.w = (float)obj->cur_sprite->width + b.h * SHADOW_SKEW;
+  return b;
+}
+
+// Rebuild sorted static partition if static objects changed. Returns false on allocation failure.
+bool render_list_prepare(RenderList *list);
+
+#endif
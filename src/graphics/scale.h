@@ -0,0 +1,26 @@
+#ifndef SCALE_H
+#define SCALE_H
+
+#include <engine/types.h>
+#include <stdint.h>
+
+// Fixed-point format of resampler coordinates: 16 fractional bits
+#define SCALE_FP_SHIFT 16
+#define SCALE_FP_ONE (1 << SCALE_FP_SHIFT)
+
+// Size of 'size' source pixels after scaling by 'zoom'. At least 1 for non-empty source.
+uint32_t scaled_size(uint32_t size, float zoom);
+
+// Alpha-blend 'sprite' scaled by 'zoom' onto framebuffer with top-left corner at screen (x, y).
+// Parts outside of the framebuffer are clipped before the pixel loops.
+// Zoom 1 is a plain copy, integer zoom replicates every source pixel, fractional zoom uses
+// fixed-point nearest-neighbour resampling.
+void blit_scaled(uint32_t *framebuffer,
+    uint32_t fb_width,
+    uint32_t fb_height,
+    const Sprite *sprite,
+    int x,
+    int y,
+    float zoom);
+
+#endif
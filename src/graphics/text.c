@@ -0,0 +1,222 @@
+#include "graphics/alpha_blend.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <engine/memory.h>
+#include <engine/text.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Cached characters: printable ASCII
+#define GLYPH_FIRST 32
+#define GLYPH_LAST 126
+#define GLYPH_COUNT (GLYPH_LAST - GLYPH_FIRST + 1)
+#define GLYPH_FALLBACK '?'
+// Minimal atlas width. Glyphs are packed left-to-right into rows ("shelves") of this width.
+#define ATLAS_MIN_WIDTH 512
+
+// Place of a glyph in the atlas
+typedef struct {
+  uint32_t x, y; // top-left corner in atlas
+  uint32_t w, h; // 0 if glyph has no pixels (space) or the font doesn't provide it
+  int advance;   // pen movement after the glyph, 0 if the font doesn't provide it
+} Glyph;
+
+struct GlyphAtlas {
+  uint8_t *coverage; // alpha of all glyphs, width x height
+  uint32_t width;
+  uint32_t height;
+  uint32_t line_height;
+  Glyph glyphs[GLYPH_COUNT];
+};
+
+// Rasterize white glyph in ARGB8888 format
+static SDL_Surface *render_glyph(TTF_Font *font, uint16_t ch) {
+  SDL_Surface *surf = TTF_RenderGlyph_Blended(font, ch, (SDL_Color){255, 255, 255, 255});
+  if (!surf || surf->format->format == SDL_PIXELFORMAT_ARGB8888) return surf;
+
+  SDL_Surface *converted = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ARGB8888, 0);
+  SDL_FreeSurface(surf);
+  return converted;
+}
+
+GlyphAtlas *glyph_atlas_create(TTF_Font *font) {
+  if (!font) return NULL;
+  GlyphAtlas *atlas = calloc(1, sizeof(GlyphAtlas));
+  if (!atlas) return NULL;
+  atlas->line_height = (uint32_t)TTF_FontHeight(font);
+
+  // Rasterize every glyph once
+  SDL_Surface *surfs[GLYPH_COUNT] = {0};
+  uint32_t width = ATLAS_MIN_WIDTH;
+  for (int i = 0; i < GLYPH_COUNT; i++) {
+    uint16_t ch = (uint16_t)(GLYPH_FIRST + i);
+    int advance = 0;
+    if (!TTF_GlyphIsProvided(font, ch)) continue;
+    if (TTF_GlyphMetrics(font, ch, NULL, NULL, NULL, NULL, &advance) != 0) continue;
+    atlas->glyphs[i].advance = advance;
+
+    surfs[i] = render_glyph(font, ch);
+    if (surfs[i] && (uint32_t)surfs[i]->w > width) width = (uint32_t)surfs[i]->w;
+  }
+
+  // Pack glyphs into shelves
+  uint32_t pen_x = 0, shelf_y = 0, shelf_h = 0;
+  for (int i = 0; i < GLYPH_COUNT; i++) {
+    if (!surfs[i]) continue;
+    Glyph *g = &atlas->glyphs[i];
+    g->w = (uint32_t)surfs[i]->w;
+    g->h = (uint32_t)surfs[i]->h;
+    if (pen_x + g->w > width) {
+      shelf_y += shelf_h;
+      pen_x = shelf_h = 0;
+    }
+    g->x = pen_x;
+    g->y = shelf_y;
+    pen_x += g->w;
+    if (g->h > shelf_h) shelf_h = g->h;
+  }
+  atlas->width = width;
+  atlas->height = shelf_y + shelf_h;
+
+  // Keep only alpha: glyphs are white, color is applied when drawing
+  atlas->coverage = memory_calloc(MEMORY_TEXT, (size_t)atlas->width * atlas->height + 1, sizeof(uint8_t));
+  for (int i = 0; i < GLYPH_COUNT; i++) {
+    if (!surfs[i]) continue;
+    const Glyph *g = &atlas->glyphs[i];
+    if (atlas->coverage) {
+      for (uint32_t y = 0; y < g->h; y++) {
+        const uint8_t *src_row = (const uint8_t *)surfs[i]->pixels + (size_t)y * surfs[i]->pitch;
+        const uint32_t *src = (const uint32_t *)src_row;
+        uint8_t *dst = atlas->coverage + (size_t)(g->y + y) * atlas->width + g->x;
+        for (uint32_t x = 0; x < g->w; x++) { dst[x] = (uint8_t)(src[x] >> 24); }
+      }
+    }
+    SDL_FreeSurface(surfs[i]);
+  }
+
+  if (!atlas->coverage) {
+    free(atlas);
+    return NULL;
+  }
+  return atlas;
+}
+
+void glyph_atlas_free(GlyphAtlas *atlas) {
+  if (!atlas) return;
+  memory_free(atlas->coverage);
+  free(atlas);
+}
+
+uint32_t glyph_atlas_line_height(const GlyphAtlas *atlas) {
+  return atlas ? atlas->line_height : 0;
+}
+
+// Glyph for byte of UTF-8 text. Returns NULL for continuation bytes of multibyte characters,
+// so every character is drawn once.
+static inline const Glyph *find_glyph(const GlyphAtlas *atlas, unsigned char c) {
+  if ((c & 0xC0) == 0x80) return NULL;
+  if (c >= GLYPH_FIRST && c <= GLYPH_LAST && atlas->glyphs[c - GLYPH_FIRST].advance > 0) {
+    return &atlas->glyphs[c - GLYPH_FIRST];
+  }
+  return &atlas->glyphs[GLYPH_FALLBACK - GLYPH_FIRST];
+}
+
+uint32_t text_measure(const GlyphAtlas *atlas, const char *text) {
+  if (!atlas || !text) return 0;
+
+  // Last glyph can be wider than its advance
+  uint32_t pen_x = 0, width = 0;
+  for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+    const Glyph *g = find_glyph(atlas, *c);
+    if (!g) continue;
+    if (pen_x + g->w > width) width = pen_x + g->w;
+    pen_x += (uint32_t)g->advance;
+  }
+  return pen_x > width ? pen_x : width;
+}
+
+// Copy glyphs of 'text' into 'dst'. If 'blend' is set, text is alpha-blended over destination,
+// otherwise every pixel keeps the most opaque glyph pixel written into it (destination is cleared).
+static void compose_text(const GlyphAtlas *atlas,
+    uint32_t *dst,
+    uint32_t dst_width,
+    uint32_t dst_height,
+    int x,
+    int y,
+    const char *text,
+    uint32_t color,
+    bool blend) {
+  uint32_t rgb = color & 0x00FFFFFF;
+  uint32_t color_a = color >> 24;
+  int pen_x = x;
+
+  for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+    const Glyph *g = find_glyph(atlas, *c);
+    if (!g) continue;
+
+    // Clip glyph rectangle by destination
+    int x0 = pen_x < 0 ? -pen_x : 0;
+    int y0 = y < 0 ? -y : 0;
+    int x1 = (int)g->w, y1 = (int)g->h;
+    if (pen_x + x1 > (int)dst_width) x1 = (int)dst_width - pen_x;
+    if (y + y1 > (int)dst_height) y1 = (int)dst_height - y;
+
+    for (int gy = y0; gy < y1; gy++) {
+      const uint8_t *src = atlas->coverage + (size_t)(g->y + gy) * atlas->width + g->x;
+      uint32_t *row = dst + (size_t)(y + gy) * dst_width;
+      for (int gx = x0; gx < x1; gx++) {
+        uint32_t a = src[gx] * color_a / 255;
+        if (a == 0) continue;
+        uint32_t pixel = (a << 24) | rgb;
+        uint32_t *out = &row[pen_x + gx];
+        if (blend) {
+          *out = alpha_blend(pixel, *out);
+        } else if (a > (*out >> 24)) {
+          *out = pixel;
+        }
+      }
+    }
+    pen_x += g->advance;
+  }
+}
+
+void text_draw(const GlyphAtlas *atlas,
+    uint32_t *dst,
+    uint32_t dst_width,
+    uint32_t dst_height,
+    int x,
+    int y,
+    const char *text,
+    uint32_t color) {
+  if (!atlas || !dst || !text) return;
+  compose_text(atlas, dst, dst_width, dst_height, x, y, text, color, true);
+}
+
+bool text_label_set(TextLabel *label, const GlyphAtlas *atlas, const char *text, uint32_t color) {
+  if (!label || !atlas || !text) return false;
+
+  uint32_t width = text_measure(atlas, text);
+  uint32_t height = atlas->line_height;
+  size_t size = (size_t)width * height;
+  if (size > label->capacity) {
+    uint32_t *pixels = memory_realloc(MEMORY_TEXT, label->sprite.pixels, size * sizeof(uint32_t));
+    if (!pixels) return false;
+    label->sprite.pixels = pixels;
+    label->capacity = size;
+  }
+
+  label->sprite.width = width;
+  label->sprite.height = height;
+  if (size == 0) return true;
+  memset(label->sprite.pixels, 0, size * sizeof(uint32_t));
+  compose_text(atlas, label->sprite.pixels, width, height, 0, 0, text, color, false);
+  return true;
+}
+
+void text_label_free(TextLabel *label) {
+  if (!label) return;
+  memory_free(label->sprite.pixels);
+  *label = (TextLabel){0};
+}
@@ -0,0 +1,246 @@
+#include "graphics/alpha_blend.h"
+#include "graphics/ui_priv.h"
+#include <engine/memory.h>
+#include <engine/types.h>
+#include <engine/ui.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+UILayer *ui_layer_create(void) {
+  return calloc(1, sizeof(UILayer));
+}
+
+void ui_layer_free(UILayer *layer) {
+  if (!layer) return;
+  for (uint32_t i = 0; i < layer->segment_capacity; i++) { memory_free(layer->segments[i].pixels); }
+  memory_free(layer->segments);
+  memory_free(layer->entries);
+  free(layer);
+}
+
+static int32_t find_entry(const UILayer *layer, const UIElement *ui) {
+  for (uint32_t i = 0; i < layer->count; i++) {
+    if (layer->entries[i].ui == ui) return (int32_t)i;
+  }
+  return -1;
+}
+
+static void snapshot_entry(UIEntry *entry) {
+  UIElement *ui = entry->ui;
+  entry->z_index = ui->z_index;
+  entry->mode = ui->mode;
+  entry->screen = ui->mode == UI_POS_SCREEN ? ui->position.screen : (Vector){0.0f, 0.0f};
+  entry->width = ui->sprite ? ui->sprite->width : 0;
+  entry->height = ui->sprite ? ui->sprite->height : 0;
+}
+
+// Insert keeping order by z-index. Equal z-indices keep order of insertion.
+static void insert_sorted(UILayer *layer, UIElement *ui) {
+  uint32_t pos = layer->count;
+  while (pos > 0 && layer->entries[pos - 1].z_index > ui->z_index) pos--;
+  memmove(&layer->entries[pos + 1], &layer->entries[pos], (layer->count - pos) * sizeof(UIEntry));
+
+  layer->entries[pos] = (UIEntry){.ui = ui, .segment = -1};
+  snapshot_entry(&layer->entries[pos]);
+  layer->count++;
+}
+
+static void remove_at(UILayer *layer, uint32_t index) {
+  memmove(&layer->entries[index],
+      &layer->entries[index + 1],
+      (layer->count - index - 1) * sizeof(UIEntry));
+  layer->count--;
+}
+
+bool ui_layer_add(UILayer *layer, UIElement *ui) {
+  if (!layer || !ui) return false;
+  if (find_entry(layer, ui) >= 0) return true;
+
+  if (layer->count == layer->capacity) {
+    uint32_t new_capacity = layer->capacity ? layer->capacity * 2 : 16;
+    UIEntry *entries = memory_realloc(MEMORY_UI, layer->entries, new_capacity * sizeof(UIEntry));
+    if (!entries) return false;
+    layer->entries = entries;
+    layer->capacity = new_capacity;
+  }
+
+  insert_sorted(layer, ui);
+  layer->layout_dirty = true;
+  return true;
+}
+
+void ui_layer_remove(UILayer *layer, UIElement *ui) {
+  if (!layer || !ui) return;
+  int32_t index = find_entry(layer, ui);
+  if (index < 0) return;
+
+  remove_at(layer, (uint32_t)index);
+  layer->layout_dirty = true;
+}
+
+void ui_layer_invalidate(UILayer *layer, UIElement *ui) {
+  if (!layer || !ui) return;
+  int32_t index = find_entry(layer, ui);
+  if (index < 0) return;
+
+  UIEntry *entry = &layer->entries[index];
+  uint32_t width = ui->sprite ? ui->sprite->width : 0;
+  uint32_t height = ui->sprite ? ui->sprite->height : 0;
+
+  if (entry->z_index != ui->z_index) {
+    // Move to the new place in z order
+    remove_at(layer, (uint32_t)index);
+    insert_sorted(layer, ui);
+    layer->layout_dirty = true;
+  } else if (entry->mode != ui->mode || width != entry->width || height != entry->height ||
+      (ui->mode == UI_POS_SCREEN &&
+          (ui->position.screen.x != entry->screen.x || ui->position.screen.y != entry->screen.y))) {
+    // Overlay bounds change
+    snapshot_entry(entry);
+    layer->layout_dirty = true;
+  } else if (entry->segment >= 0) {
+    // Only pixels changed
+    layer->segments[entry->segment].dirty = true;
+  }
+}
+
+static bool push_segment(UILayer *layer, uint32_t first) {
+  if (layer->segment_count == layer->segment_capacity) {
+    uint32_t new_capacity = layer->segment_capacity ? layer->segment_capacity * 2 : 4;
+    UISegment *segments = memory_realloc(MEMORY_UI, layer->segments, new_capacity * sizeof(UISegment));
+    if (!segments) return false;
+    // New segments have no buffers yet, old ones keep theirs for reuse
+    uint32_t added = new_capacity - layer->segment_capacity;
+    memset(&segments[layer->segment_capacity], 0, added * sizeof(UISegment));
+    layer->segments = segments;
+    layer->segment_capacity = new_capacity;
+  }
+
+  UISegment *seg = &layer->segments[layer->segment_count++];
+  seg->first = first;
+  seg->count = 0;
+  seg->dirty = true;
+  return true;
+}
+
+// Segment bounding box may grow by at most that many areas of the added element. Otherwise the element
+// starts a new segment, so far-apart elements (corners of the HUD) don't share a mostly transparent
+// overlay, that is blended every frame and recomposited whenever any of them changes.
+#define UI_SEGMENT_MAX_GROWTH 2
+
+// Split sorted elements into runs of nearby screen-space elements and compute their screen bounds
+static void build_segments(UILayer *layer) {
+  layer->segment_count = 0;
+  UISegment *seg = NULL;
+
+  for (uint32_t i = 0; i < layer->count; i++) {
+    UIEntry *entry = &layer->entries[i];
+    snapshot_entry(entry);
+    entry->segment = -1;
+    if (entry->mode != UI_POS_SCREEN || !entry->ui->sprite) {
+      seg = NULL;
+      continue;
+    }
+
+    // Bounding box with the element, kept as [x, x + width) x [y, y + height)
+    int32_t x0 = (int32_t)entry->screen.x, y0 = (int32_t)entry->screen.y;
+    int32_t x1 = x0 + (int32_t)entry->width, y1 = y0 + (int32_t)entry->height;
+    if (seg) {
+      int32_t sx1 = seg->x + (int32_t)seg->width, sy1 = seg->y + (int32_t)seg->height;
+      int32_t mx0 = seg->x < x0 ? seg->x : x0, my0 = seg->y < y0 ? seg->y : y0;
+      int32_t mx1 = sx1 > x1 ? sx1 : x1, my1 = sy1 > y1 ? sy1 : y1;
+      uint64_t area = (uint64_t)entry->width * entry->height;
+      uint64_t growth = (uint64_t)(mx1 - mx0) * (uint64_t)(my1 - my0) - (uint64_t)seg->width * seg->height;
+      if (growth > UI_SEGMENT_MAX_GROWTH * area) {
+        seg = NULL;
+      } else {
+        x0 = mx0;
+        y0 = my0;
+        x1 = mx1;
+        y1 = my1;
+      }
+    }
+    if (!seg) {
+      // Without memory for a segment elements are drawn directly
+      if (!push_segment(layer, i)) continue;
+      seg = &layer->segments[layer->segment_count - 1];
+    }
+
+    seg->x = x0;
+    seg->y = y0;
+    seg->width = (uint32_t)(x1 - x0);
+    seg->height = (uint32_t)(y1 - y0);
+    seg->count++;
+    entry->segment = (int32_t)(layer->segment_count - 1);
+  }
+
+  // Overlays never extend beyond the screen
+  for (uint32_t s = 0; s < layer->segment_count; s++) {
+    UISegment *sg = &layer->segments[s];
+    int32_t x0 = sg->x < 0 ? 0 : sg->x, y0 = sg->y < 0 ? 0 : sg->y;
+    int32_t x1 = sg->x + (int32_t)sg->width, y1 = sg->y + (int32_t)sg->height;
+    if (x1 > (int32_t)layer->screen_width) x1 = (int32_t)layer->screen_width;
+    if (y1 > (int32_t)layer->screen_height) y1 = (int32_t)layer->screen_height;
+    sg->x = x0;
+    sg->y = y0;
+    sg->width = x1 > x0 ? (uint32_t)(x1 - x0) : 0;
+    sg->height = y1 > y0 ? (uint32_t)(y1 - y0) : 0;
+  }
+}
+
+// Composite elements of the segment over transparent background
+static void composite_segment(UILayer *layer, UISegment *seg) {
+  size_t size = (size_t)seg->width * seg->height;
+  if (size > seg->capacity) {
+    uint32_t *pixels = memory_realloc(MEMORY_UI, seg->pixels, size * sizeof(uint32_t));
+    if (!pixels) {
+      seg->width = seg->height = 0;
+      return;
+    }
+    seg->pixels = pixels;
+    seg->capacity = size;
+  }
+  if (size == 0) return;
+  memset(seg->pixels, 0, size * sizeof(uint32_t));
+
+  for (uint32_t i = seg->first; i < seg->first + seg->count; i++) {
+    const Sprite *sprite = layer->entries[i].ui->sprite;
+    int32_t ox = (int32_t)layer->entries[i].screen.x - seg->x;
+    int32_t oy = (int32_t)layer->entries[i].screen.y - seg->y;
+
+    for (uint32_t sy = 0; sy < sprite->height; sy++) {
+      int32_t y = oy + (int32_t)sy;
+      if (y < 0 || y >= (int32_t)seg->height) continue;
+      uint32_t *row = seg->pixels + (size_t)y * seg->width;
+      const uint32_t *src = sprite->pixels + (size_t)sy * sprite->width;
+      for (uint32_t sx = 0; sx < sprite->width; sx++) {
+        int32_t x = ox + (int32_t)sx;
+        if (x < 0 || x >= (int32_t)seg->width) continue;
+        row[x] = alpha_over(src[sx], row[x]);
+      }
+    }
+  }
+}
+
+void ui_layer_prepare(UILayer *layer, uint32_t screen_width, uint32_t screen_height) {
+  if (!layer) return;
+
+  if (screen_width != layer->screen_width || screen_height != layer->screen_height) {
+    layer->screen_width = screen_width;
+    layer->screen_height = screen_height;
+    layer->layout_dirty = true;
+  }
+  if (layer->layout_dirty) {
+    build_segments(layer);
+    layer->layout_dirty = false;
+  }
+
+  for (uint32_t s = 0; s < layer->segment_count; s++) {
+    UISegment *seg = &layer->segments[s];
+    if (!seg->dirty) continue;
+    composite_segment(layer, seg);
+    seg->dirty = false;
+  }
+}
@@ -0,0 +1,46 @@
+#ifndef UI_PRIV_H
+#define UI_PRIV_H
+
+#include <engine/types.h>
+#include <engine/ui.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Registered element with values it had when layout was built, to detect layout changes
+typedef struct {
+  UIElement *ui;
+  int z_index;
+  UIPositionMode mode;
+  Vector screen;
+  uint32_t width, height;
+  int32_t segment; // index of cached segment, -1 for elements drawn directly
+} UIEntry;
+
+// Cached composition of consecutive screen-space elements [first, first + count)
+typedef struct {
+  uint32_t first, count;
+  int32_t x, y;          // top-left corner of the overlay on screen
+  uint32_t width, height; // bounding box of elements clipped by screen
+  uint32_t *pixels;
+  size_t capacity;
+  bool dirty;
+} UISegment;
+
+struct UILayer {
+  UIEntry *entries; // sorted by z-index, equal z-indices keep order of addition
+  uint32_t count;
+  uint32_t capacity;
+
+  UISegment *segments;
+  uint32_t segment_count;
+  uint32_t segment_capacity;
+
+  uint32_t screen_width, screen_height;
+  bool layout_dirty; // order or segments must be rebuilt
+};
+
+// Rebuild layout if needed and recomposite invalidated overlays for screen of given size
+void ui_layer_prepare(UILayer *layer, uint32_t screen_width, uint32_t screen_height);
+
+#endif
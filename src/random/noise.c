@@ -0,0 +1,245 @@
+#include "random/random_priv.h"
+#include <engine/map.h>
+#include <engine/noise.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Rows are processed in chunks of this size, so temporary buffers stay on stack and in L1 cache.
+#define NOISE_CHUNK 256
+
+// Simplex skew factors for 2D: 0.5 * (sqrt(3) - 1) and (3 - sqrt(3)) / 6
+#define SIMPLEX_F2 0.36602540378f
+#define SIMPLEX_G2 0.21132486540f
+
+// Kernels below are written without branches and function calls in the inner loops,
+// so the compiler can vectorize them (several lanes of a row per instruction).
+
+static inline int fast_floor(float x) {
+  int i = (int)x;
+  return i - (x < (float)i);
+}
+
+// Smootherstep 6t^5 - 15t^4 + 10t^3
+static inline float fade(float t) {
+  return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+static inline float lerp(float a, float b, float t) {
+  return a + (b - a) * t;
+}
+
+static inline uint32_t hash_seeded(int x, int y, uint32_t seed) {
+  // Mixed in uint32_t: adding the seed to int coordinates could overflow
+  return hash_u32((uint32_t)x + seed * 0x9E3779B9u, (uint32_t)y ^ seed);
+}
+
+// Lattice value in range [-1, 1]. Same low bits as rand01 uses.
+static inline float lattice_value(uint32_t h) {
+  return (float)(h & 0xFFFF) * (2.0f / 65535.0f) - 1.0f;
+}
+
+// Dot product of (dx, dy) with one of 8 gradients chosen by hash:
+// 4 diagonals (+-1, +-1) and 4 axes (+-1, 0), (0, +-1).
+static inline float grad_dot(uint32_t h, float dx, float dy) {
+  float b0 = (float)(h & 1);
+  float b1 = (float)((h >> 1) & 1);
+  float b2 = (float)((h >> 2) & 1);
+  float sx = 1.0f - 2.0f * b0;
+  float sy = 1.0f - 2.0f * b1;
+  float gx = sx * (1.0f - b2 * b1);
+  float gy = (1.0f - b2) * sy + b2 * b1 * sx;
+  return gx * dx + gy * dy;
+}
+
+// Value noise over a row. y is constant for a row, so its lattice cell is computed once.
+static void row_value(uint32_t seed, float x0, float step, float y, float amp, float *acc, uint32_t count) {
+  int yi = fast_floor(y);
+  float v = fade(y - (float)yi);
+
+  for (uint32_t i = 0; i < count; i++) {
+    float x = x0 + (float)i * step;
+    int xi = fast_floor(x);
+    float u = fade(x - (float)xi);
+
+    float n00 = lattice_value(hash_seeded(xi, yi, seed));
+    float n10 = lattice_value(hash_seeded(xi + 1, yi, seed));
+    float n01 = lattice_value(hash_seeded(xi, yi + 1, seed));
+    float n11 = lattice_value(hash_seeded(xi + 1, yi + 1, seed));
+
+    acc[i] += amp * lerp(lerp(n00, n10, u), lerp(n01, n11, u), v);
+  }
+}
+
+// Gradient (Perlin-like) noise over a row
+static void row_gradient(uint32_t seed,
+    float x0,
+    float step,
+    float y,
+    float amp,
+    float *acc,
+    uint32_t count) {
+  int yi = fast_floor(y);
+  float fy = y - (float)yi;
+  float v = fade(fy);
+
+  for (uint32_t i = 0; i < count; i++) {
+    float x = x0 + (float)i * step;
+    int xi = fast_floor(x);
+    float fx = x - (float)xi;
+    float u = fade(fx);
+
+    float n00 = grad_dot(hash_seeded(xi, yi, seed), fx, fy);
+    float n10 = grad_dot(hash_seeded(xi + 1, yi, seed), fx - 1.0f, fy);
+    float n01 = grad_dot(hash_seeded(xi, yi + 1, seed), fx, fy - 1.0f);
+    float n11 = grad_dot(hash_seeded(xi + 1, yi + 1, seed), fx - 1.0f, fy - 1.0f);
+
+    acc[i] += amp * lerp(lerp(n00, n10, u), lerp(n01, n11, u), v);
+  }
+}
+
+static inline float simplex_corner(uint32_t h, float dx, float dy) {
+  float t = 0.5f - dx * dx - dy * dy;
+  t = 0.5f * (t + fabsf(t)); // max(t, 0) that vectorizes
+  t *= t;
+  return t * t * grad_dot(h, dx, dy);
+}
+
+// Simplex noise over a row. Triangle choice is done with selects instead of branches.
+static void row_simplex(uint32_t seed, float x0, float step, float y, float amp, float *acc, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    float x = x0 + (float)i * step;
+
+    float s = (x + y) * SIMPLEX_F2;
+    int ci = fast_floor(x + s);
+    int cj = fast_floor(y + s);
+    float t = (float)(ci + cj) * SIMPLEX_G2;
+    float dx0 = x - ((float)ci - t);
+    float dy0 = y - ((float)cj - t);
+
+    int i1 = dx0 > dy0;
+    int j1 = 1 - i1;
+    float dx1 = dx0 - (float)i1 + SIMPLEX_G2;
+    float dy1 = dy0 - (float)j1 + SIMPLEX_G2;
+    float dx2 = dx0 - 1.0f + 2.0f * SIMPLEX_G2;
+    float dy2 = dy0 - 1.0f + 2.0f * SIMPLEX_G2;
+
+    float n = simplex_corner(hash_seeded(ci, cj, seed), dx0, dy0) +
+        simplex_corner(hash_seeded(ci + i1, cj + j1, seed), dx1, dy1) +
+        simplex_corner(hash_seeded(ci + 1, cj + 1, seed), dx2, dy2);
+
+    // Scale to approximately [-1, 1]
+    acc[i] += amp * 70.0f * n;
+  }
+}
+
+NoiseParams noise_default_params(NoiseType type, uint32_t seed) {
+  NoiseParams params;
+  params.type = type;
+  params.seed = seed;
+  params.frequency = 1.0f / 16.0f;
+  params.octaves = 4;
+  params.lacunarity = 2.0f;
+  params.gain = 0.5f;
+  return params;
+}
+
+// Evaluate all octaves for a chunk of a row and map result into [0, 1]
+static void fill_chunk(const NoiseParams *p, float x0, float y, float step, float *out, uint32_t count) {
+  float acc[NOISE_CHUNK] = {0};
+
+  float freq = p->frequency;
+  float amp = 1.0f;
+  float amp_sum = 0.0f;
+  int octaves = p->octaves > 0 ? p->octaves : 1;
+  for (int o = 0; o < octaves; o++) {
+    // Different seed per octave, so layers are not correlated
+    uint32_t seed = p->seed + (uint32_t)o * 1013904223u;
+    float ox = x0 * freq, oy = y * freq, ostep = step * freq;
+
+    switch (p->type) {
+    case NOISE_VALUE: row_value(seed, ox, ostep, oy, amp, acc, count); break;
+    case NOISE_GRADIENT: row_gradient(seed, ox, ostep, oy, amp, acc, count); break;
+    case NOISE_SIMPLEX: row_simplex(seed, ox, ostep, oy, amp, acc, count); break;
+    }
+
+    amp_sum += amp;
+    freq *= p->lacunarity;
+    amp *= p->gain;
+  }
+
+  float norm = amp_sum > 0.0f ? 0.5f / amp_sum : 0.0f;
+  for (uint32_t i = 0; i < count; i++) {
+    float v = 0.5f + acc[i] * norm;
+    v = v < 0.0f ? 0.0f : v;
+    out[i] = v > 1.0f ? 1.0f : v;
+  }
+}
+
+void noise_fill_row(const NoiseParams *params, float x0, float y, float step, float *out, uint32_t count) {
+  if (!params || !out) return;
+
+  for (uint32_t start = 0; start < count; start += NOISE_CHUNK) {
+    uint32_t n = count - start < NOISE_CHUNK ? count - start : NOISE_CHUNK;
+    fill_chunk(params, x0 + (float)start * step, y, step, out + start, n);
+  }
+}
+
+float noise_sample(const NoiseParams *params, float x, float y) {
+  float v = 0.0f;
+  noise_fill_row(params, x, y, 0.0f, &v, 1);
+  return v;
+}
+
+void noise_fill(const NoiseParams *params, float *out, uint32_t width, uint32_t height) {
+  if (!params || !out) return;
+
+  for (uint32_t y = 0; y < height; y++) {
+    noise_fill_row(params, 0.0f, (float)y, 1.0f, out + (size_t)y * width, width);
+  }
+}
+
+bool noise_fill_tiles(const NoiseParams *params,
+    TilesInfo *ti,
+    uint32_t width,
+    uint32_t height,
+    const float *thresholds) {
+  if (!params || !ti || ti->sprite_count == 0 || width == 0) return false;
+
+  bool allocated = false;
+  if (!ti->tiles) {
+    ti->tiles = calloc((size_t)width * height, sizeof(uint32_t));
+    if (!ti->tiles) return false;
+    allocated = true;
+  }
+
+  float *row = malloc(width * sizeof(float));
+  if (!row) {
+    if (allocated) {
+      free(ti->tiles);
+      ti->tiles = NULL;
+    }
+    return false;
+  }
+
+  uint32_t last = ti->sprite_count - 1;
+  for (uint32_t y = 0; y < height; y++) {
+    noise_fill_row(params, 0.0f, (float)y, 1.0f, row, width);
+    uint32_t *tiles = ti->tiles + (size_t)y * width;
+
+    for (uint32_t x = 0; x < width; x++) {
+      uint32_t idx = 0;
+      if (thresholds) {
+        while (idx < last && row[x] >= thresholds[idx]) idx++;
+      } else {
+        idx = (uint32_t)(row[x] * (float)ti->sprite_count);
+        if (idx > last) idx = last;
+      }
+      tiles[x] = idx;
+    }
+  }
+
+  free(row);
+  return true;
+}
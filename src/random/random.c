@@ -1,29 +1,113 @@
+#include "random/random_priv.h"
+#include <engine/random.h>
 #include <engine/types.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <time.h>
 
-uint32_t hash_u32(int x, int y) {
-  uint32_t h = (uint32_t)(x * 374761393u + y * 668265263u);
-  h = (h ^ (h >> 13)) * 1274126177u;
-  return h ^ (h >> 16);
+float rand01(int x, int y) {
+  return (hash_u32((uint32_t)x, (uint32_t)y) & 0xFFFF) / 65535.0f;
 }
 
-float rand01(int x, int y) {
-  return (hash_u32(x, y) & 0xFFFF) / 65535.0f;
+static inline uint32_t rotl(uint32_t x, int k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+// SplitMix64 step, used to expand a 64-bit seed into the generator state
+static uint64_t splitmix64(uint64_t *state) {
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+void rng_seed(Rng *rng, uint64_t seed) {
+  if (!rng) return;
+  uint64_t a = splitmix64(&seed);
+  uint64_t b = splitmix64(&seed);
+  rng->s[0] = (uint32_t)a;
+  rng->s[1] = (uint32_t)(a >> 32);
+  rng->s[2] = (uint32_t)b;
+  rng->s[3] = (uint32_t)(b >> 32);
+  // All-zero state is the only invalid one
+  if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0) rng->s[0] = 1;
+}
+
+uint32_t rng_next(Rng *rng) {
+  uint32_t *s = rng->s;
+  uint32_t result = rotl(s[1] * 5, 7) * 9;
+  uint32_t t = s[1] << 9;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl(s[3], 11);
+
+  return result;
+}
+
+float rng_float01(Rng *rng) {
+  // Top 24 bits fit exactly into float mantissa
+  return (float)(rng_next(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+uint32_t rng_range(Rng *rng, uint32_t bound) {
+  // Lemire's multiply-shift reduction: no division, bias is negligible for game use
+  return (uint32_t)(((uint64_t)rng_next(rng) * bound) >> 32);
+}
+
+Rng rng_split(Rng *parent) {
+  Rng child = *parent;
+
+  // xoshiro128 jump polynomial: equivalent to 2^64 calls of rng_next
+  static const uint32_t jump[] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+  uint32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  for (int i = 0; i < 4; i++) {
+    for (int b = 0; b < 32; b++) {
+      if (jump[i] & (1u << b)) {
+        s0 ^= parent->s[0];
+        s1 ^= parent->s[1];
+        s2 ^= parent->s[2];
+        s3 ^= parent->s[3];
+      }
+      rng_next(parent);
+    }
+  }
+  parent->s[0] = s0;
+  parent->s[1] = s1;
+  parent->s[2] = s2;
+  parent->s[3] = s3;
+
+  return child;
+}
+
+void rng_fill_u32(Rng *rng, uint32_t *out, size_t count) {
+  if (!rng || !out) return;
+  // Work on a local copy so the state stays in registers
+  Rng local = *rng;
+  for (size_t i = 0; i < count; i++) { out[i] = rng_next(&local); }
+  *rng = local;
+}
+
+void rng_fill_float01(Rng *rng, float *out, size_t count) {
+  if (!rng || !out) return;
+  Rng local = *rng;
+  for (size_t i = 0; i < count; i++) { out[i] = rng_float01(&local); }
+  *rng = local;
 }
 
+static Rng global_rng;
 static bool random_initialized = false;
 
+void rand_seed(uint64_t seed) {
+  rng_seed(&global_rng, seed);
+  random_initialized = true;
+}
+
 uint32_t rand_big() {
-  if (!random_initialized) {
-    srand((unsigned int)time(NULL));
-    random_initialized = true;
-  }
-  uint32_t result = 0;
-  result = (rand() & 0x7FFF);
-  result |= (rand() & 0x7FFF) << 15;
-  result |= (rand() & 0x0003) << 30;
-  return result;
+  if (!random_initialized) rand_seed((uint64_t)time(NULL));
+  return rng_next(&global_rng);
 }
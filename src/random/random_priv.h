@@ -3,6 +3,15 @@
 
 #include <stdint.h>
 
-uint32_t hash_u32(int x, int y);
+// Integer hash of lattice point coordinates.
+//
+// Inline so that batch loops over rows (noise) can be vectorized by the compiler.
+// Coordinates are unsigned, so callers can mix in offsets with wrap-around; int coordinates
+// convert with the same bits.
+static inline uint32_t hash_u32(uint32_t x, uint32_t y) {
+  uint32_t h = x * 374761393u + y * 668265263u;
+  h = (h ^ (h >> 13)) * 1274126177u;
+  return h ^ (h >> 16);
+}
 
 #endif
@@ -0,0 +1,180 @@
+#include <engine/collision.h>
+#include <engine/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Insertion sort is used while it does not exceed that number of moves per object,
+// otherwise order is considered lost and the full sort is used.
+#define MAX_SHIFTS_PER_OBJECT 8
+
+typedef struct {
+  float min_x;
+  uint32_t id;
+} SapEntry;
+
+struct CollisionWorld {
+  SapEntry *entries; // Objects sorted by left edge, kept between calls
+  uint32_t count;    // Number of objects on previous call
+  uint32_t capacity;
+
+  // Footprints in sorted order, so the sweep reads memory sequentially
+  float *max_x, *min_y, *max_y;
+
+  ContactPair *pairs;
+  uint32_t pair_count;
+  uint32_t pair_capacity;
+};
+
+CollisionWorld *collision_create(uint32_t capacity) {
+  CollisionWorld *cw = calloc(1, sizeof(CollisionWorld));
+  if (!cw) return NULL;
+
+  cw->pair_capacity = 64;
+  cw->pairs = malloc(cw->pair_capacity * sizeof(ContactPair));
+  if (!cw->pairs) {
+    free(cw);
+    return NULL;
+  }
+
+  cw->capacity = capacity;
+  if (capacity > 0) {
+    cw->entries = malloc(capacity * sizeof(SapEntry));
+    cw->max_x = malloc(capacity * sizeof(float));
+    cw->min_y = malloc(capacity * sizeof(float));
+    cw->max_y = malloc(capacity * sizeof(float));
+    if (!cw->entries || !cw->max_x || !cw->min_y || !cw->max_y) {
+      collision_free(cw);
+      return NULL;
+    }
+  }
+
+  return cw;
+}
+
+void collision_free(CollisionWorld *cw) {
+  if (!cw) return;
+
+  free(cw->entries);
+  free(cw->max_x);
+  free(cw->min_y);
+  free(cw->max_y);
+  free(cw->pairs);
+  free(cw);
+}
+
+Rect object_footprint(Vector position, const Sprite *sprite) {
+  if (!sprite) return (Rect){position, 0.0f, 0.0f};
+
+  float x_offset = sprite->width * 0.3f;
+  float y_offset = sprite->height * 0.1f;
+  Rect r;
+  r.pos = (Vector){position.x + x_offset, position.y + sprite->height - y_offset};
+  r.w = sprite->width - 2.0f * x_offset;
+  r.h = y_offset;
+  return r;
+}
+
+void collision_footprints(const Vector *positions, Sprite *const *sprites, uint32_t count, Rect *out) {
+  if (!positions || !sprites || !out) return;
+  for (uint32_t i = 0; i < count; i++) { out[i] = object_footprint(positions[i], sprites[i]); }
+}
+
+static bool ensure_capacity(CollisionWorld *cw, uint32_t count) {
+  if (count <= cw->capacity) return true;
+
+  SapEntry *entries = realloc(cw->entries, count * sizeof(SapEntry));
+  if (entries) cw->entries = entries;
+  float *max_x = realloc(cw->max_x, count * sizeof(float));
+  if (max_x) cw->max_x = max_x;
+  float *min_y = realloc(cw->min_y, count * sizeof(float));
+  if (min_y) cw->min_y = min_y;
+  float *max_y = realloc(cw->max_y, count * sizeof(float));
+  if (max_y) cw->max_y = max_y;
+  if (!entries || !max_x || !min_y || !max_y) return false;
+
+  cw->capacity = count;
+  return true;
+}
+
+static int compare_entries(const void *a, const void *b) {
+  float ka = ((const SapEntry *)a)->min_x;
+  float kb = ((const SapEntry *)b)->min_x;
+  return (ka > kb) - (ka < kb);
+}
+
+// Insertion sort, fast for almost sorted arrays. Returns false if gave up because of too many moves.
+static bool insertion_sort(SapEntry *entries, uint32_t count) {
+  uint64_t budget = (uint64_t)count * MAX_SHIFTS_PER_OBJECT;
+  for (uint32_t i = 1; i < count; i++) {
+    SapEntry e = entries[i];
+    uint32_t j = i;
+    while (j > 0 && entries[j - 1].min_x > e.min_x) {
+      entries[j] = entries[j - 1];
+      j--;
+      if (--budget == 0) {
+        entries[j] = e;
+        return false;
+      }
+    }
+    entries[j] = e;
+  }
+  return true;
+}
+
+static inline bool push_pair(CollisionWorld *cw, uint32_t a, uint32_t b) {
+  if (cw->pair_count == cw->pair_capacity) {
+    ContactPair *pairs = realloc(cw->pairs, cw->pair_capacity * 2 * sizeof(ContactPair));
+    if (!pairs) return false;
+    cw->pairs = pairs;
+    cw->pair_capacity *= 2;
+  }
+  cw->pairs[cw->pair_count++] = a < b ? (ContactPair){a, b} : (ContactPair){b, a};
+  return true;
+}
+
+const ContactPair *
+collision_find_pairs(CollisionWorld *cw, const Rect *rects, uint32_t count, uint32_t *pair_count) {
+  if (pair_count) *pair_count = 0;
+  if (!cw || !rects) return NULL;
+  cw->pair_count = 0;
+  if (!ensure_capacity(cw, count)) return cw->pairs;
+
+  SapEntry *entries = cw->entries;
+  if (count == cw->count) {
+    // Same objects as before: refresh keys and restore order
+    for (uint32_t i = 0; i < count; i++) { entries[i].min_x = rects[entries[i].id].pos.x; }
+    if (!insertion_sort(entries, count)) qsort(entries, count, sizeof(SapEntry), compare_entries);
+  } else {
+    for (uint32_t i = 0; i < count; i++) { entries[i] = (SapEntry){rects[i].pos.x, i}; }
+    qsort(entries, count, sizeof(SapEntry), compare_entries);
+    cw->count = count;
+  }
+
+  for (uint32_t k = 0; k < count; k++) {
+    const Rect *r = &rects[entries[k].id];
+    cw->max_x[k] = r->pos.x + r->w;
+    cw->min_y[k] = r->pos.y;
+    cw->max_y[k] = r->pos.y + r->h;
+  }
+
+  // Sweep: compare each object only with following objects which start before it ends on X axis
+  bool out_of_memory = false;
+  for (uint32_t i = 0; i < count && !out_of_memory; i++) {
+    float max_x = cw->max_x[i];
+    float min_y = cw->min_y[i], max_y = cw->max_y[i];
+    if (max_x <= entries[i].min_x) continue; // empty footprint
+
+    for (uint32_t j = i + 1; j < count && entries[j].min_x < max_x; j++) {
+      if (cw->min_y[j] < max_y && min_y < cw->max_y[j] && cw->max_x[j] > entries[j].min_x) {
+        if (!push_pair(cw, entries[i].id, entries[j].id)) {
+          out_of_memory = true;
+          break;
+        }
+      }
+    }
+  }
+
+  if (pair_count) *pair_count = cw->pair_count;
+  return cw->pairs;
+}
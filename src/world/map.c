@@ -5,6 +5,7 @@
 #include "random/random_priv.h"
 #include "world/map_priv.h"
 #include <engine/coordinates.h>
+#include <engine/memory.h>
 #include <engine/random.h>
 #include <engine/types.h>
 #include <math.h>
@@ -14,7 +15,6 @@
 
 static bool map_is_valid_position(const Map *map, uint32_t x, uint32_t y);
 static Sprite *map_get_tile(const Map *map, uint32_t x, uint32_t y);
-static void map_render_tiles(Map *map);
 
 // Create map with given tile width and height.
 //
@@ -33,6 +33,7 @@ Map *map_create(uint32_t width, uint32_t height, TilesInfo ti) {
     return NULL;
   }
   map->ti = ti;
+  memory_track(MEMORY_MAP, ti.tiles, (size_t)width * height * sizeof(uint32_t));
 
   map->width = width;
   map->height = height;
@@ -58,13 +59,17 @@ Map *map_create(uint32_t width, uint32_t height, TilesInfo ti) {
   map->width_pix = (width + height) * (map->tile_width / 2);
   map->height_pix = (width + height) * (map->tile_height / 2) + ti.sides_height;
 
-  map->pixels = (uint32_t *)calloc(map->width_pix * map->height_pix, sizeof(uint32_t));
+  map->pixels = memory_calloc(MEMORY_MAP, (size_t)map->width_pix * map->height_pix, sizeof(uint32_t));
   if (!map->pixels) {
     map_free(map);
     return NULL;
   }
 
   map_render_tiles(map);
+  if (!map_build_mips(map)) {
+    map_free(map);
+    return NULL;
+  }
 
   return map;
 }
@@ -72,9 +77,10 @@ Map *map_create(uint32_t width, uint32_t height, TilesInfo ti) {
 void map_free(Map *map) {
   if (!map) return;
 
-  if (map->pixels) { free(map->pixels); }
+  map_free_mips(map);
+  memory_free(map->pixels);
   free_sprites(map->ti.tile_sprites, map->ti.sprite_count);
-  if (map->ti.tiles) { free(map->ti.tiles); }
+  memory_free(map->ti.tiles);
   free(map);
 }
 
@@ -87,6 +93,29 @@ VectorU32 map_get_size(Map *map) {
   return size;
 }
 
+bool map_bake_objects(Map *map, GameObject **objs, uint32_t count) {
+  if (!map || (!objs && count > 0)) return false;
+  if (count == 0) return true;
+
+  // Whole map as a single view: world and screen pixels are the same
+  Camera camera = {0};
+  camera.size = (Vector){(float)map->width_pix, (float)map->height_pix};
+  camera.zoom = 1.0f;
+  RenderBatch batch = {0};
+  batch.objs = objs;
+  batch.obj_count = count;
+  // Depth order is prepared here rather than by render_batch, so its allocation failure is reported
+  Arena *arena = arena_create(0);
+  RenderShared shared = {0};
+  bool prepared = arena && render_prepare_objects(&shared, &batch, arena, 1.0f);
+  if (prepared) render_view_objects(map->pixels, &batch, &shared, &camera, 1.0f);
+  arena_free(arena);
+  if (!prepared) return false;
+
+  map_free_mips(map);
+  return map_build_mips(map);
+}
+
 inline static bool map_is_valid_position(const Map *map, uint32_t x, uint32_t y) {
   if (!map) return false;
   return (x < map->width && y < map->height);
@@ -99,7 +128,7 @@ inline static Sprite *map_get_tile(const Map *map, uint32_t x, uint32_t y) {
   return NULL;
 }
 
-static void map_render_tiles(Map *map) {
+void map_render_tiles(Map *map) {
   if (!map || !map->ti.tiles) return;
 
   // Tile coordinates
@@ -179,24 +208,66 @@ bool is_point_within_map(Map *map, Vector pos, uint32_t margin) {
   return pointInQuadrangle(mc.t, mc.r, mc.b, mc.l, (Vector){pos.x, pos.y});
 }
 
-VectorU32 map_gen_random_position(Map *map, uint32_t margin) {
-  Vector center = tile_to_world(map, map->width / 2, map->height / 2);
-  VectorU32 pos = {(uint32_t)center.x, (uint32_t)center.y};
-  if (!map || margin >= (map->width_pix / 2) || margin >= (map->height_pix / 2)) return pos;
+// The margin-shrunk map area is still a parallelogram: moving top/bottom corners vertically and left/right
+// corners horizontally by the same margin keeps t + b == l + r. So every point of it can be written as
+// t + u * (r - t) + v * (l - t) with u, v in [0, 1), which maps two uniform numbers directly into the area.
+typedef struct {
+  Vector origin, edge_u, edge_v;
+} MapSampler;
+
+// Returns false if the margin is too big and the shrunk area is empty or turned inside out.
+static bool map_sampler_init(Map *map, uint32_t margin, MapSampler *s) {
+  if (margin >= (map->width_pix / 2) || margin >= (map->height_pix / 2)) return false;
 
+  MapCorners full = get_map_corners(map, 0);
   MapCorners mc = get_map_corners(map, margin);
 
-  uint32_t range_x = mc.r.x - mc.l.x;
-  uint32_t range_y = mc.b.y - mc.t.y;
-  for (int i = 0; i < 100; i++) {
-    Vector p = {mc.l.x + (rand_big() % range_x), mc.t.y + (rand_big() % range_y)};
+  s->origin = mc.t;
+  s->edge_u = (Vector){mc.r.x - mc.t.x, mc.r.y - mc.t.y};
+  s->edge_v = (Vector){mc.l.x - mc.t.x, mc.l.y - mc.t.y};
 
-    if (pointInQuadrangle(mc.t, mc.r, mc.b, mc.l, p)) {
-      pos.x = (uint32_t)p.x;
-      pos.y = (uint32_t)p.y;
-      return pos;
-    }
-  }
+  float full_cross =
+      (full.r.x - full.t.x) * (full.l.y - full.t.y) - (full.r.y - full.t.y) * (full.l.x - full.t.x);
+  float cross = s->edge_u.x * s->edge_v.y - s->edge_u.y * s->edge_v.x;
+  return (cross > 0.0f) == (full_cross > 0.0f) && cross != 0.0f;
+}
+
+// Uniform float in [0, 1) from the top 24 bits of a random number
+static inline float rand_unit(void) {
+  return (float)(rand_big() >> 8) * (1.0f / 16777216.0f);
+}
 
+static inline VectorU32 map_sampler_next(const MapSampler *s) {
+  float u = rand_unit();
+  float v = rand_unit();
+  VectorU32 pos;
+  pos.x = (uint32_t)(s->origin.x + u * s->edge_u.x + v * s->edge_v.x);
+  pos.y = (uint32_t)(s->origin.y + u * s->edge_u.y + v * s->edge_v.y);
   return pos;
 }
+
+static VectorU32 map_center(Map *map) {
+  Vector center = tile_to_world(map, map->width / 2, map->height / 2);
+  return (VectorU32){(uint32_t)center.x, (uint32_t)center.y};
+}
+
+VectorU32 map_gen_random_position(Map *map, uint32_t margin) {
+  if (!map) return (VectorU32){0, 0};
+
+  MapSampler s;
+  if (!map_sampler_init(map, margin, &s)) return map_center(map);
+  return map_sampler_next(&s);
+}
+
+void map_gen_random_positions(Map *map, uint32_t margin, VectorU32 *out, uint32_t count) {
+  if (!map || !out) return;
+
+  MapSampler s;
+  if (!map_sampler_init(map, margin, &s)) {
+    VectorU32 center = map_center(map);
+    for (uint32_t i = 0; i < count; i++) { out[i] = center; }
+    return;
+  }
+
+  for (uint32_t i = 0; i < count; i++) { out[i] = map_sampler_next(&s); }
+}
@@ -0,0 +1,107 @@
+#include "graphics/scale.h"
+#include "world/map_priv.h"
+#include <engine/map.h>
+#include <engine/memory.h>
+#include <engine/types.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Average of 2x2 block (fewer pixels on odd edges). Colors are weighted by alpha,
+// so transparent pixels around the map don't darken its border.
+static inline uint32_t box_filter(const uint32_t *src,
+    uint32_t src_w,
+    uint32_t src_h,
+    uint32_t x,
+    uint32_t y) {
+  uint32_t sum_a = 0, sum_r = 0, sum_g = 0, sum_b = 0, n = 0;
+  for (uint32_t sy = 2 * y; sy < 2 * y + 2 && sy < src_h; sy++) {
+    for (uint32_t sx = 2 * x; sx < 2 * x + 2 && sx < src_w; sx++) {
+      uint32_t p = src[sy * src_w + sx];
+      uint32_t a = p >> 24;
+      sum_a += a;
+      sum_r += ((p >> 16) & 0xFF) * a;
+      sum_g += ((p >> 8) & 0xFF) * a;
+      sum_b += (p & 0xFF) * a;
+      n++;
+    }
+  }
+  if (sum_a == 0) return 0;
+
+  uint32_t a = (sum_a + n / 2) / n;
+  uint32_t r = (sum_r + sum_a / 2) / sum_a;
+  uint32_t g = (sum_g + sum_a / 2) / sum_a;
+  uint32_t b = (sum_b + sum_a / 2) / sum_a;
+  return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+static void downsample(const Sprite *src, Sprite *dst) {
+  for (uint32_t y = 0; y < dst->height; y++) {
+    uint32_t *row = dst->pixels + (size_t)y * dst->width;
+    for (uint32_t x = 0; x < dst->width; x++) {
+      row[x] = box_filter(src->pixels, src->width, src->height, x, y);
+    }
+  }
+}
+
+bool map_build_mips(Map *map) {
+  if (!map || !map->pixels) return false;
+
+  map->mips[0] = (Sprite){map->pixels, map->width_pix, map->height_pix};
+  map->mip_count = 1;
+
+  while (map->mip_count < MAP_MAX_MIPS) {
+    const Sprite *prev = &map->mips[map->mip_count - 1];
+    if (prev->width <= 1 && prev->height <= 1) break;
+
+    Sprite *level = &map->mips[map->mip_count];
+    level->width = (prev->width + 1) / 2;
+    level->height = (prev->height + 1) / 2;
+    level->pixels = memory_alloc(MEMORY_MAP, (size_t)level->width * level->height * sizeof(uint32_t));
+    if (!level->pixels) {
+      map_free_mips(map);
+      return false;
+    }
+    downsample(prev, level);
+    map->mip_count++;
+  }
+  return true;
+}
+
+void map_free_mips(Map *map) {
+  if (!map) return;
+  // Level 0 is 'pixels', owned by map itself
+  for (uint32_t i = 1; i < map->mip_count; i++) { memory_free(map->mips[i].pixels); }
+  map->mip_count = 0;
+}
+
+const Sprite *map_mip_for_zoom(const Map *map, float zoom, float *level_zoom) {
+  uint32_t level = 0;
+  // Every level halves the number of pixels, so its zoom doubles
+  while (level + 1 < map->mip_count && zoom * 2.0f <= 1.0f) {
+    zoom *= 2.0f;
+    level++;
+  }
+  *level_zoom = zoom;
+  return &map->mips[level];
+}
+
+uint32_t map_mip_count(const Map *map) {
+  return map ? map->mip_count : 0;
+}
+
+float map_render_overview(const Map *map, uint32_t *dst, uint32_t dst_width, uint32_t dst_height) {
+  if (!map || !dst || map->mip_count == 0 || map->width_pix == 0 || map->height_pix == 0) return 0.0f;
+
+  // Fit the whole map keeping aspect ratio
+  float scale = fminf((float)dst_width / map->width_pix, (float)dst_height / map->height_pix);
+  if (scale <= 0.0f) return 0.0f;
+
+  float level_zoom;
+  const Sprite *level = map_mip_for_zoom(map, scale, &level_zoom);
+  int x = ((int)dst_width - (int)scaled_size(map->width_pix, scale)) / 2;
+  int y = ((int)dst_height - (int)scaled_size(map->height_pix, scale)) / 2;
+  blit_scaled(dst, dst_width, dst_height, level, x, y, level_zoom);
+  return scale;
+}
@@ -9,6 +9,8 @@
 
 #define ISO_TILE_WIDTH 64
 #define ISO_TILE_HEIGHT 32
+// Enough for maps up to 65536 pixels wide
+#define MAP_MAX_MIPS 17
 
 typedef struct Map {
   uint32_t width, height;
@@ -17,6 +19,20 @@ typedef struct Map {
 
   TilesInfo ti;
   uint32_t tile_width, tile_height;
+
+  // Mip chain of prerendered map. Level 0 shares 'pixels', every next level is half the size
+  // of the previous one, down to 1x1.
+  Sprite mips[MAP_MAX_MIPS];
+  uint32_t mip_count;
 } Map;
 
+// Blend all tile sprites into 'pixels'. Called by map_create, mips have to be rebuilt after it.
+void map_render_tiles(Map *map);
+// Build mip chain from 'pixels'. Returns false on allocation failure.
+bool map_build_mips(Map *map);
+void map_free_mips(Map *map);
+// Mip level to draw the map at 'zoom' (screen pixels per world pixel): the smallest level that still
+// has at least one pixel per screen pixel. 'level_zoom' receives zoom to apply to that level.
+const Sprite *map_mip_for_zoom(const Map *map, float zoom, float *level_zoom);
+
 #endif
@@ -0,0 +1,203 @@
+#include "random/random_priv.h"
+#include <engine/spatial_hash.h>
+#include <engine/types.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Points are stored sorted by hash bucket (counting sort), so every bucket is a contiguous range
+// of 'ids' and 'points'. Positions are copied next to indices to avoid random access on queries.
+struct SpatialHash {
+  float cell_size;
+  float inv_cell_size;
+
+  uint32_t count;
+  uint32_t capacity;
+  uint32_t *ids;  // Original indices of points, grouped by bucket
+  Vector *points; // Positions in the same order as ids
+  uint32_t *cell_of;
+
+  uint32_t bucket_mask;
+  uint32_t *bucket_start; // bucket_mask + 2 elements: bucket b is [bucket_start[b], bucket_start[b + 1])
+};
+
+// Cell coordinates are clamped, so far-away (or infinite) positions fit int and end up in edge cells
+#define CELL_COORD_LIMIT (1 << 30)
+
+static inline int cell_coord(const SpatialHash *sh, float v) {
+  float c = floorf(v * sh->inv_cell_size);
+  if (!(c > (float)-CELL_COORD_LIMIT)) return -CELL_COORD_LIMIT; // NaN too
+  if (c > (float)CELL_COORD_LIMIT) return CELL_COORD_LIMIT;
+  return (int)c;
+}
+
+static inline bool is_inside(Vector p,
+    Vector min,
+    Vector max,
+    Vector center,
+    float radius_sq,
+    bool is_circle) {
+  if (is_circle) {
+    float dx = p.x - center.x, dy = p.y - center.y;
+    return dx * dx + dy * dy <= radius_sq;
+  }
+  return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y;
+}
+
+static inline uint32_t bucket_of(const SpatialHash *sh, int cx, int cy) {
+  return hash_u32((uint32_t)cx, (uint32_t)cy) & sh->bucket_mask;
+}
+
+// Bucket table has at least 2 buckets per point, rounded up to power of two
+static bool ensure_capacity(SpatialHash *sh, uint32_t count) {
+  if (count <= sh->capacity && sh->ids) return true;
+
+  uint32_t capacity = count > sh->capacity ? count : sh->capacity;
+  uint32_t buckets = 16;
+  while (buckets < capacity * 2) buckets <<= 1;
+
+  uint32_t *ids = realloc(sh->ids, capacity * sizeof(uint32_t));
+  if (ids) sh->ids = ids;
+  Vector *points = realloc(sh->points, capacity * sizeof(Vector));
+  if (points) sh->points = points;
+  uint32_t *cell_of = realloc(sh->cell_of, capacity * sizeof(uint32_t));
+  if (cell_of) sh->cell_of = cell_of;
+  uint32_t *bucket_start = realloc(sh->bucket_start, (buckets + 1) * sizeof(uint32_t));
+  if (bucket_start) sh->bucket_start = bucket_start;
+  if (!ids || !points || !cell_of || !bucket_start) return false;
+
+  sh->capacity = capacity;
+  sh->bucket_mask = buckets - 1;
+  return true;
+}
+
+SpatialHash *spatial_hash_create(float cell_size, uint32_t capacity) {
+  if (cell_size <= 0.0f) return NULL;
+  SpatialHash *sh = calloc(1, sizeof(SpatialHash));
+  if (!sh) return NULL;
+
+  sh->cell_size = cell_size;
+  sh->inv_cell_size = 1.0f / cell_size;
+  sh->capacity = capacity > 0 ? capacity : 1;
+  if (!ensure_capacity(sh, sh->capacity)) {
+    spatial_hash_free(sh);
+    return NULL;
+  }
+
+  return sh;
+}
+
+void spatial_hash_free(SpatialHash *sh) {
+  if (!sh) return;
+
+  free(sh->ids);
+  free(sh->points);
+  free(sh->cell_of);
+  free(sh->bucket_start);
+  free(sh);
+}
+
+// Generic build over positions with given stride in bytes
+static void build_strided(SpatialHash *sh, const char *base, size_t stride, uint32_t count) {
+  sh->count = 0;
+  if (!ensure_capacity(sh, count)) return;
+
+  uint32_t buckets = sh->bucket_mask + 1;
+  memset(sh->bucket_start, 0, (buckets + 1) * sizeof(uint32_t));
+
+  // Count points per bucket. 'cell_of' temporarily keeps bucket of every point.
+  for (uint32_t i = 0; i < count; i++) {
+    Vector p = *(const Vector *)(base + i * stride);
+    uint32_t b = bucket_of(sh, cell_coord(sh, p.x), cell_coord(sh, p.y));
+    sh->cell_of[i] = b;
+    sh->bucket_start[b + 1]++;
+  }
+
+  // Prefix sum: bucket_start[b] is the first slot of bucket b
+  for (uint32_t b = 0; b < buckets; b++) { sh->bucket_start[b + 1] += sh->bucket_start[b]; }
+
+  // Scatter points. bucket_start[b] is used as insertion cursor and ends up at the end of bucket b,
+  // so it's shifted back afterwards.
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t slot = sh->bucket_start[sh->cell_of[i]]++;
+    sh->ids[slot] = i;
+    sh->points[slot] = *(const Vector *)(base + i * stride);
+  }
+  memmove(sh->bucket_start + 1, sh->bucket_start, buckets * sizeof(uint32_t));
+  sh->bucket_start[0] = 0;
+
+  sh->count = count;
+}
+
+void spatial_hash_build(SpatialHash *sh, const Vector *positions, uint32_t count) {
+  if (!sh || (!positions && count > 0)) return;
+  build_strided(sh, (const char *)positions, sizeof(Vector), count);
+}
+
+void spatial_hash_build_objects(SpatialHash *sh, const GameObject *objects, uint32_t count) {
+  if (!sh || (!objects && count > 0)) return;
+  build_strided(sh, (const char *)&objects[0].position, sizeof(GameObject), count);
+}
+
+// Visit all cells overlapping [min, max] and collect points accepted by the shape test.
+// Different cells may share a bucket, so a point is accepted only when its own cell is visited.
+// Areas of more cells than buckets are cheaper to handle by testing every point, so the cost
+// of a query never exceeds a full scan.
+static uint32_t query_area(const SpatialHash *sh,
+    Vector min,
+    Vector max,
+    Vector center,
+    float radius_sq,
+    bool is_circle,
+    uint32_t *out,
+    uint32_t max_out) {
+  if (!sh || !out || sh->count == 0) return 0;
+
+  int cx0 = cell_coord(sh, min.x), cx1 = cell_coord(sh, max.x);
+  int cy0 = cell_coord(sh, min.y), cy1 = cell_coord(sh, max.y);
+  if (cx0 > cx1 || cy0 > cy1) return 0;
+  uint32_t found = 0;
+
+  uint64_t cells = (uint64_t)((int64_t)cx1 - cx0 + 1) * (uint64_t)((int64_t)cy1 - cy0 + 1);
+  if (cells > (uint64_t)sh->bucket_mask + 1) {
+    for (uint32_t s = 0; s < sh->count; s++) {
+      if (!is_inside(sh->points[s], min, max, center, radius_sq, is_circle)) continue;
+      out[found++] = sh->ids[s];
+      if (found == max_out) return found;
+    }
+    return found;
+  }
+
+  for (int cy = cy0; cy <= cy1; cy++) {
+    for (int cx = cx0; cx <= cx1; cx++) {
+      uint32_t b = bucket_of(sh, cx, cy);
+      for (uint32_t s = sh->bucket_start[b]; s < sh->bucket_start[b + 1]; s++) {
+        Vector p = sh->points[s];
+        if (cell_coord(sh, p.x) != cx || cell_coord(sh, p.y) != cy) continue;
+        if (!is_inside(p, min, max, center, radius_sq, is_circle)) continue;
+
+        out[found++] = sh->ids[s];
+        if (found == max_out) return found;
+      }
+    }
+  }
+
+  return found;
+}
+
+uint32_t spatial_hash_query_radius(const SpatialHash *sh,
+    Vector center,
+    float radius,
+    uint32_t *out,
+    uint32_t max_out) {
+  if (radius < 0.0f) return 0;
+  Vector min = {center.x - radius, center.y - radius};
+  Vector max = {center.x + radius, center.y + radius};
+  return query_area(sh, min, max, center, radius * radius, true, out, max_out);
+}
+
+uint32_t spatial_hash_query_rect(const SpatialHash *sh, Rect rect, uint32_t *out, uint32_t max_out) {
+  Vector max = {rect.pos.x + rect.w, rect.pos.y + rect.h};
+  return query_area(sh, rect.pos, max, rect.pos, 0.0f, false, out, max_out);
+}
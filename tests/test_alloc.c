@@ -0,0 +1,70 @@
+#include "test_framework.h"
+#include <engine/alloc.h>
+#include <stdint.h>
+#include <string.h>
+
+static bool is_aligned(const void *ptr) {
+  return ((uintptr_t)ptr % ALLOC_ALIGN) == 0;
+}
+
+REGISTER_TEST(arena_alloc_is_aligned_and_contiguous) {
+  Arena *arena = arena_create(256);
+  TEST_ASSERT_NOT_NULL(arena, "Failed to create arena");
+
+  uint8_t *a = arena_alloc(arena, 3);
+  uint8_t *b = arena_alloc(arena, 40);
+  TEST_ASSERT_NOT_NULL(a, "Allocation failed");
+  TEST_ASSERT_NOT_NULL(b, "Allocation failed");
+  TEST_ASSERT(is_aligned(a) && is_aligned(b), "Arena memory should be aligned");
+  TEST_ASSERT_EQ(b - a, ALLOC_ALIGN, "Allocations should follow each other");
+  TEST_ASSERT_NULL(arena_alloc(arena, 0), "Zero-size allocation should return NULL");
+
+  ArenaStats stats = arena_stats(arena);
+  TEST_ASSERT_EQ(stats.allocations, 2, "Allocation count mismatch");
+  TEST_ASSERT_EQ(stats.used, 16 + 48, "Used bytes should include alignment");
+  TEST_ASSERT_EQ(stats.overflows, 0, "Nothing should overflow");
+
+  uint32_t *zeroed = arena_calloc(arena, 4, sizeof(uint32_t));
+  TEST_ASSERT_NOT_NULL(zeroed, "Allocation failed");
+  for (int i = 0; i < 4; i++) TEST_ASSERT_EQ(zeroed[i], 0, "arena_calloc memory should be zeroed");
+
+  arena_free(arena);
+}
+
+REGISTER_TEST(arena_reset_reuses_memory) {
+  Arena *arena = arena_create(128);
+  void *first = arena_alloc(arena, 64);
+  arena_reset(arena);
+  void *again = arena_alloc(arena, 64);
+  TEST_ASSERT(first == again, "Reset should start from the beginning of the buffer");
+
+  ArenaStats stats = arena_stats(arena);
+  TEST_ASSERT_EQ(stats.allocations, 1, "Reset should clear allocation count");
+  TEST_ASSERT_EQ(stats.resets, 1, "Reset count mismatch");
+  arena_free(arena);
+}
+
+// Overflowing allocations still succeed, and after reset the buffer fits the whole frame
+REGISTER_TEST(arena_overflow_grows_on_reset) {
+  Arena *arena = arena_create(64);
+  uint8_t *ptrs[8];
+  for (int i = 0; i < 8; i++) {
+    ptrs[i] = arena_alloc(arena, 32);
+    TEST_ASSERT_NOT_NULL(ptrs[i], "Allocation should not fail on overflow");
+    TEST_ASSERT(is_aligned(ptrs[i]), "Overflow memory should be aligned");
+    memset(ptrs[i], i, 32);
+  }
+  for (int i = 0; i < 8; i++) TEST_ASSERT_EQ(ptrs[i][31], i, "Allocations should not overlap");
+
+  ArenaStats stats = arena_stats(arena);
+  TEST_ASSERT_EQ(stats.overflows, 6, "Two allocations fit the buffer, the rest should overflow");
+  TEST_ASSERT_EQ(stats.peak, 8 * 32, "Peak should include overflow");
+
+  arena_reset(arena);
+  stats = arena_stats(arena);
+  TEST_ASSERT_EQ(stats.capacity, 8 * 32, "Buffer should grow to peak usage");
+  for (int i = 0; i < 8; i++) arena_alloc(arena, 32);
+  TEST_ASSERT_EQ(arena_stats(arena).overflows, 6, "Same frame should fit after growing");
+
+  arena_free(arena);
+}
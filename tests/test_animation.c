@@ -0,0 +1,59 @@
+#include "test_framework.h"
+#include <engine/animation.h>
+
+#define STEP (1.0f / 60.0f)
+
+// Frames change with clip frame time, non-looping clip switches to its next clip
+REGISTER_TEST(animation_advance_and_chain) {
+  Sprite frames[5] = {0};
+  // Clip 0: 3 frames, then clip 1. Clip 1: 2 frames, looping.
+  AnimClip clips[2] = {{0, 3, 100, 1}, {3, 2, 100, 1}};
+  AnimSet set = {frames, clips, 2, NULL, 0, 0};
+
+  Animator *an = animator_create();
+  TEST_ASSERT_NOT_NULL(an, "Failed to create animator");
+  uint16_t set_idx = animator_add_set(an, set);
+
+  EntityAnim anim = {0};
+  Sprite *sprite = NULL;
+  animator_start(an, &anim, &sprite, set_idx);
+  bool first_ok = sprite == &frames[0];
+
+  // 0.5 s: 5 frame changes of 100 ms -> clip 0 frames 1, 2, then clip 1 frames 0, 1, 0
+  for (int i = 0; i < 30; i++) {
+    animator_tick(an, STEP);
+    animator_advance(an, &anim, &sprite, 1);
+  }
+  animator_free(an);
+
+  TEST_ASSERT(first_ok, "Start must set the first frame");
+  TEST_ASSERT_EQ(anim.clip, 1, "Clip must switch to the next one");
+  TEST_ASSERT(sprite == &frames[3], "Looping clip must wrap to its first frame");
+}
+
+// Set table stops growing at ANIM_MAX_SETS, failures are reported with ANIM_SET_NONE
+REGISTER_TEST(animation_set_limit) {
+  Sprite frames[1] = {0};
+  AnimClip clips[1] = {{0, 1, 0, 0}};
+  AnimSet set = {frames, clips, 1, NULL, 0, 0};
+  TEST_ASSERT_EQ(animator_add_set(NULL, set), ANIM_SET_NONE, "NULL animator must fail");
+
+  Animator *an = animator_create();
+  TEST_ASSERT_NOT_NULL(an, "Failed to create animator");
+  bool sequential = true;
+  for (uint32_t i = 0; i < ANIM_MAX_SETS; i++) {
+    if (animator_add_set(an, set) != i) sequential = false;
+  }
+  uint16_t extra = animator_add_set(an, set);
+
+  // Last set is still usable after the failed registration
+  EntityAnim anim = {0};
+  Sprite *sprite = NULL;
+  animator_start(an, &anim, &sprite, ANIM_MAX_SETS - 1);
+  animator_free(an);
+
+  TEST_ASSERT(sequential, "Sets must get consecutive indices");
+  TEST_ASSERT_EQ(extra, ANIM_SET_NONE, "Set beyond the limit must fail");
+  TEST_ASSERT_EQ(anim.set, ANIM_MAX_SETS - 1, "Last set must stay valid");
+  TEST_ASSERT(sprite == &frames[0], "Last set must start playing");
+}
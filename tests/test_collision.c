@@ -0,0 +1,46 @@
+#include "test_framework.h"
+#include <engine/collision.h>
+
+#define RECTS 400
+
+static int brute_force_pairs(const Rect *rects, int count) {
+  int pairs = 0;
+  for (int i = 0; i < count; i++) {
+    for (int j = i + 1; j < count; j++) {
+      Rect a = rects[i], b = rects[j];
+      if (a.pos.x < b.pos.x + b.w && b.pos.x < a.pos.x + a.w && a.pos.y < b.pos.y + b.h &&
+          b.pos.y < a.pos.y + a.h) {
+        pairs++;
+      }
+    }
+  }
+  return pairs;
+}
+
+// Sweep and prune must find the same pairs as brute force, also after objects move
+REGISTER_TEST(collision_pairs_match_brute_force) {
+  Rect rects[RECTS];
+  for (int i = 0; i < RECTS; i++) {
+    rects[i] = (Rect){{(float)((i * 53) % 500), (float)((i * 29) % 300)}, 12.0f + i % 7, 6.0f + i % 5};
+  }
+
+  CollisionWorld *cw = collision_create(16);
+  TEST_ASSERT_NOT_NULL(cw, "Failed to create collision world");
+
+  for (int tick = 0; tick < 3; tick++) {
+    uint32_t count = 0;
+    const ContactPair *pairs = collision_find_pairs(cw, rects, RECTS, &count);
+    int expected = brute_force_pairs(rects, RECTS);
+    bool ordered = true;
+    for (uint32_t k = 0; k < count; k++) {
+      if (pairs[k].a >= pairs[k].b) ordered = false;
+    }
+    TEST_ASSERT_EQ((int)count, expected, "Pair count differs from brute force");
+    TEST_ASSERT(ordered, "Pairs must have a < b");
+
+    // Move objects a bit, so the next call re-sorts previous order
+    for (int i = 0; i < RECTS; i++) { rects[i].pos.x += (float)((i * 7) % 11) - 5.0f; }
+  }
+
+  collision_free(cw);
+}
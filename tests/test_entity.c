@@ -0,0 +1,84 @@
+#include "test_framework.h"
+#include <engine/entity.h>
+
+// Removing an entity moves the last one into its place
+REGISTER_TEST(entity_store_add_remove) {
+  EntityStore *store = entity_store_create(3, sizeof(int));
+  TEST_ASSERT_NOT_NULL(store, "Failed to create store");
+
+  Handle entities[3];
+  for (int i = 0; i < 3; i++) {
+    entities[i] = entity_store_add(store, (Vector){(float)i, 0.0f}, NULL);
+    *(int *)entity_store_user(store, entity_store_index(store, entities[i])) = i * 10;
+  }
+  Handle overflow = entity_store_add(store, (Vector){0.0f, 0.0f}, NULL);
+
+  entity_store_remove(store, entities[0]);
+  entity_store_sync_objects(store);
+
+  uint32_t count = store->count;
+  float moved_x = store->positions[0].x;
+  float object_x = entity_store_object_at(store, 0)->position.x;
+  int moved_user = *(int *)entity_store_user(store, 0);
+  uint32_t moved_index = entity_store_index(store, entities[2]);
+  entity_store_free(store);
+
+  TEST_ASSERT(handle_equal(overflow, HANDLE_NONE), "Full store must reject new entities");
+  TEST_ASSERT_EQ(count, 2, "Count after removal");
+  TEST_ASSERT_FLOAT_EQ(moved_x, 2.0f, 0.001f, "Last entity must be moved into removed slot");
+  TEST_ASSERT_FLOAT_EQ(object_x, 2.0f, 0.001f, "Render view must follow positions");
+  TEST_ASSERT_EQ(moved_user, 20, "User component must move with entity");
+  TEST_ASSERT_EQ(moved_index, 0, "Handle must follow moved entity");
+}
+
+// Handles and render objects stay valid across removals of other entities; removed ones go stale
+REGISTER_TEST(entity_store_handles_are_stable) {
+  EntityStore *store = entity_store_create(4, 0);
+  Handle a = entity_store_add(store, (Vector){1.0f, 0.0f}, NULL);
+  Handle b = entity_store_add(store, (Vector){2.0f, 0.0f}, NULL);
+  Handle c = entity_store_add(store, (Vector){3.0f, 0.0f}, NULL);
+  GameObject *c_obj = entity_store_object(store, c);
+
+  TEST_ASSERT(entity_store_remove(store, a), "Remove failed");
+  TEST_ASSERT(!entity_store_remove(store, a), "Removing twice must fail");
+  TEST_ASSERT_EQ(entity_store_index(store, a), ENTITY_NONE, "Removed handle must be stale");
+  TEST_ASSERT_NULL(entity_store_object(store, a), "Removed entity has no object");
+
+  // Slot of 'a' is reused by the new entity, old handle must not see it
+  Handle d = entity_store_add(store, (Vector){4.0f, 0.0f}, NULL);
+  TEST_ASSERT_EQ(d.index, a.index, "Freed slot should be reused");
+  TEST_ASSERT_EQ(entity_store_index(store, a), ENTITY_NONE, "Old handle must stay stale");
+
+  entity_store_sync_objects(store);
+  TEST_ASSERT(entity_store_object(store, c) == c_obj, "Render object pointer must be stable");
+  TEST_ASSERT_FLOAT_EQ(c_obj->position.x, 3.0f, 0.001f, "Render object must follow its entity");
+  TEST_ASSERT_FLOAT_EQ(store->positions[entity_store_index(store, b)].x, 2.0f, 0.001f, "Lookup by handle");
+  for (uint32_t i = 0; i < store->count; i++) {
+    Handle h = entity_store_handle(store, i);
+    TEST_ASSERT_EQ(entity_store_index(store, h), i, "Handle at index must map back to the index");
+  }
+
+  entity_store_free(store);
+}
+
+// Every sync moves the current position of a render object to its previous one
+REGISTER_TEST(entity_store_sync_rotates_positions) {
+  EntityStore *store = entity_store_create(2, 0);
+  Handle e = entity_store_add(store, (Vector){1.0f, 2.0f}, NULL);
+  GameObject *obj = entity_store_object(store, e);
+  TEST_ASSERT(obj->interpolate, "Entities should be interpolated");
+  TEST_ASSERT_VECTOR2_EQ(obj->prev_position, obj->position, 1e-5f, "New entity doesn't move");
+
+  uint32_t i = entity_store_index(store, e);
+  store->positions[i] = (Vector){3.0f, 5.0f};
+  entity_store_sync_objects(store);
+  TEST_ASSERT_VECTOR2_EQ(obj->prev_position, ((Vector){1.0f, 2.0f}), 1e-5f, "First sync - previous");
+  TEST_ASSERT_VECTOR2_EQ(obj->position, ((Vector){3.0f, 5.0f}), 1e-5f, "First sync - current");
+
+  store->positions[i] = (Vector){7.0f, 6.0f};
+  entity_store_sync_objects(store);
+  TEST_ASSERT_VECTOR2_EQ(obj->prev_position, ((Vector){3.0f, 5.0f}), 1e-5f, "Second sync - previous");
+  TEST_ASSERT_VECTOR2_EQ(obj->position, ((Vector){7.0f, 6.0f}), 1e-5f, "Second sync - current");
+
+  entity_store_free(store);
+}
@@ -0,0 +1,316 @@
+#include "test_framework.h"
+#include <engine/engine.h>
+#include <engine/map.h>
+#include <engine/random.h>
+#include <engine/render_list.h>
+#include <engine/types.h>
+#include <engine/ui.h>
+#include <stdint.h>
+#include <string.h>
+
+// Golden-image tests: canonical scenes are rendered by a headless engine and compared with reference
+// images in tests/golden. After an intended change of rendering, review the images written next to
+// the references as <name>.actual.ppm and regenerate references with 'make update-golden'.
+
+#define GOLDEN_W 200
+#define GOLDEN_H 150
+#define GOLDEN_MAP_SIZE 12
+// Channel difference up to that is not counted, so float rounding at edges doesn't fail the tests
+#define GOLDEN_CHANNEL_TOLERANCE 8
+// Part of pixels allowed to differ more than GOLDEN_CHANNEL_TOLERANCE
+#define GOLDEN_PIXEL_TOLERANCE 0.002f
+#define DENSE_COUNT 300
+
+static bool write_ppm(const char *path, const uint32_t *pixels, int w, int h) {
+  FILE *f = fopen(path, "wb");
+  if (!f) return false;
+  fprintf(f, "P6\n%d %d\n255\n", w, h);
+  for (int i = 0; i < w * h; i++) {
+    uint8_t rgb[3] = {(uint8_t)(pixels[i] >> 16), (uint8_t)(pixels[i] >> 8), (uint8_t)pixels[i]};
+    fwrite(rgb, 1, 3, f);
+  }
+  return fclose(f) == 0;
+}
+
+// Read PPM written by write_ppm into ARGB pixels. Returns NULL if missing or of other size.
+static uint32_t *read_ppm(const char *path, int w, int h) {
+  FILE *f = fopen(path, "rb");
+  if (!f) return NULL;
+  int fw = 0, fh = 0, max = 0;
+  uint32_t *pixels = NULL;
+  if (fscanf(f, "P6 %d %d %d", &fw, &fh, &max) == 3 && fw == w && fh == h && max == 255 && fgetc(f) == '\n') {
+    pixels = malloc((size_t)w * h * sizeof(uint32_t));
+    for (int i = 0; pixels && i < w * h; i++) {
+      uint8_t rgb[3];
+      if (fread(rgb, 1, 3, f) != 3) {
+        free(pixels);
+        pixels = NULL;
+        break;
+      }
+      pixels[i] = 0xFF000000 | ((uint32_t)rgb[0] << 16) | ((uint32_t)rgb[1] << 8) | rgb[2];
+    }
+  }
+  fclose(f);
+  return pixels;
+}
+
+// Compare frame with reference image 'name'. With UPDATE_GOLDEN set, the reference is rewritten instead.
+static bool golden_match(const char *name, const uint32_t *pixels) {
+  char path[256], actual_path[256];
+  snprintf(path, sizeof(path), "tests/golden/%s.ppm", name);
+  snprintf(actual_path, sizeof(actual_path), "tests/golden/%s.actual.ppm", name);
+  if (getenv("UPDATE_GOLDEN")) return write_ppm(path, pixels, GOLDEN_W, GOLDEN_H);
+
+  uint32_t *expected = read_ppm(path, GOLDEN_W, GOLDEN_H);
+  if (!expected) {
+    fprintf(stderr, "  missing reference %s, run 'make update-golden'\n", path);
+    write_ppm(actual_path, pixels, GOLDEN_W, GOLDEN_H);
+    return false;
+  }
+
+  int differing = 0;
+  for (int i = 0; i < GOLDEN_W * GOLDEN_H; i++) {
+    for (int shift = 0; shift < 24; shift += 8) {
+      int diff = (int)((pixels[i] >> shift) & 0xFF) - (int)((expected[i] >> shift) & 0xFF);
+      if (diff > GOLDEN_CHANNEL_TOLERANCE || diff < -GOLDEN_CHANNEL_TOLERANCE) {
+        differing++;
+        break;
+      }
+    }
+  }
+  free(expected);
+
+  bool match = differing <= (int)(GOLDEN_W * GOLDEN_H * GOLDEN_PIXEL_TOLERANCE);
+  if (!match) {
+    fprintf(stderr, "  %s: %d pixels differ, see %s\n", name, differing, actual_path);
+    write_ppm(actual_path, pixels, GOLDEN_W, GOLDEN_H);
+  }
+  return match;
+}
+
+static Map *golden_map(void) {
+  TilesInfo ti = {0};
+  ti.tile_sprites = calloc(1, sizeof(Sprite));
+  ti.tile_sprites[0] = load_sprite("demo/assets/grass_high.png", 1.0f / 7.2f);
+  ti.sprite_count = 1;
+  ti.tiles = calloc(GOLDEN_MAP_SIZE * GOLDEN_MAP_SIZE, sizeof(uint32_t));
+  ti.sides_height = 64;
+  return map_create(GOLDEN_MAP_SIZE, GOLDEN_MAP_SIZE, ti);
+}
+
+static void noop_update(Input *input, void *user_data) {
+  (void)input;
+  (void)user_data;
+}
+
+// Scene: headless engine with the golden map, main view centered on 'center'
+typedef struct {
+  Engine *engine;
+  Map *map;
+  GameObject center;
+  RenderBatch batch;
+} Scene;
+
+static bool scene_init(Scene *scene, Vector center) {
+  *scene = (Scene){0};
+  scene->engine = engine_create_headless(GOLDEN_W, GOLDEN_H);
+  scene->map = golden_map();
+  if (!scene->engine || !scene->map) return false;
+  engine_set_map(scene->engine, scene->map);
+  scene->center.position = center;
+  engine_set_player(scene->engine, &scene->center);
+  engine_snap_view(scene->engine, 0);
+  return true;
+}
+
+static const uint32_t *scene_render(Scene *scene) {
+  engine_begin_frame(scene->engine, noop_update, NULL);
+  engine_render(scene->engine, &scene->batch);
+  engine_end_frame(scene->engine);
+  return engine_get_pixels(scene->engine);
+}
+
+static void scene_free(Scene *scene) {
+  engine_free(scene->engine);
+  map_free(scene->map);
+}
+
+static Vector map_center(Map *map) {
+  VectorU32 size = map_get_size(map);
+  return (Vector){size.x / 2.0f, size.y / 2.0f};
+}
+
+REGISTER_TEST(golden_map_only) {
+  Scene scene;
+  TEST_ASSERT(scene_init(&scene, (Vector){0.0f, 0.0f}), "Failed to create scene");
+  scene.center.position = map_center(scene.map);
+  engine_snap_view(scene.engine, 0);
+  bool match = golden_match("map_only", scene_render(&scene));
+  scene_free(&scene);
+  TEST_ASSERT(match, "Map differs from reference");
+}
+
+// Many overlapping objects with shadows: depth order of static and dynamic objects
+REGISTER_TEST(golden_dense_objects) {
+  Scene scene;
+  TEST_ASSERT(scene_init(&scene, (Vector){0.0f, 0.0f}), "Failed to create scene");
+  Vector center = map_center(scene.map);
+  scene.center.position = center;
+  engine_snap_view(scene.engine, 0);
+
+  Sprite sprites[2] = {load_sprite("demo/assets/bush1.png", 1.5f), load_sprite("demo/assets/tree.png", 1.0f)};
+  GameObject *objs = calloc(DENSE_COUNT, sizeof(GameObject));
+  RenderList *list = render_list_create();
+  Rng rng;
+  rng_seed(&rng, 47);
+  for (int i = 0; i < DENSE_COUNT; i++) {
+    objs[i].position.x = center.x - GOLDEN_W / 2 - 32 + rng_range(&rng, GOLDEN_W + 32);
+    objs[i].position.y = center.y - GOLDEN_H / 2 - 64 + rng_range(&rng, GOLDEN_H + 64);
+    objs[i].cur_sprite = &sprites[i % 5 == 0];
+    if (i % 2) {
+      render_list_add_static(list, &objs[i]);
+    } else {
+      render_list_add(list, &objs[i]);
+    }
+  }
+  scene.batch.render_list = list;
+
+  bool match = golden_match("dense_objects", scene_render(&scene));
+  render_list_free(list);
+  free(objs);
+  for (int i = 0; i < 2; i++) free_sprite(&sprites[i]);
+  scene_free(&scene);
+  TEST_ASSERT(match, "Dense scene differs from reference");
+}
+
+// Tall objects close up, zoomed in: shadow skew and scaled shadows
+REGISTER_TEST(golden_shadows) {
+  Scene scene;
+  TEST_ASSERT(scene_init(&scene, (Vector){0.0f, 0.0f}), "Failed to create scene");
+  Vector center = map_center(scene.map);
+  scene.center.position = center;
+  engine_set_zoom(scene.engine, 1.5f);
+  engine_snap_view(scene.engine, 0);
+
+  Sprite palm = load_sprite("demo/assets/palm.png", 1.0f);
+  GameObject objs[3] = {0};
+  GameObject *ptrs[3];
+  for (int i = 0; i < 3; i++) {
+    objs[i].position = (Vector){center.x - 60.0f + i * 40.0f, center.y - 50.0f + i * 10.0f};
+    objs[i].cur_sprite = &palm;
+    ptrs[i] = &objs[i];
+  }
+  scene.batch.objs = ptrs;
+  scene.batch.obj_count = 3;
+
+  bool match = golden_match("shadows", scene_render(&scene));
+  free_sprite(&palm);
+  scene_free(&scene);
+  TEST_ASSERT(match, "Shadows differ from reference");
+}
+
+// Screen-space elements in the retained layer and an element attached to an object
+REGISTER_TEST(golden_ui) {
+  Scene scene;
+  TEST_ASSERT(scene_init(&scene, (Vector){0.0f, 0.0f}), "Failed to create scene");
+  Vector center = map_center(scene.map);
+  scene.center.position = center;
+  engine_snap_view(scene.engine, 0);
+
+  Sprite bar = load_sprite("demo/assets/hp_bar.png", 1.0f);
+  Sprite bush = load_sprite("demo/assets/bush2.png", 1.5f);
+  GameObject obj = {0};
+  obj.position = (Vector){center.x - 20.0f, center.y - 10.0f};
+  obj.cur_sprite = &bush;
+  GameObject *ptrs[1] = {&obj};
+  scene.batch.objs = ptrs;
+  scene.batch.obj_count = 1;
+
+  UIElement uis[3] = {0};
+  uis[0].mode = uis[1].mode = UI_POS_SCREEN;
+  uis[0].position.screen = (Vector){10.0f, 10.0f};
+  uis[1].position.screen = (Vector){40.0f, 14.0f}; // overlaps the first one
+  uis[1].z_index = 1;
+  uis[2].mode = UI_POS_ATTACHED;
+  uis[2].position.attached.object = &obj;
+  uis[2].position.attached.offset = (Vector){-8.0f, -12.0f};
+  for (int i = 0; i < 3; i++) uis[i].sprite = &bar;
+  UILayer *layer = ui_layer_create();
+  for (int i = 0; i < 3; i++) ui_layer_add(layer, &uis[i]);
+  scene.batch.ui_layer = layer;
+
+  bool match = golden_match("ui", scene_render(&scene));
+  ui_layer_free(layer);
+  free_sprite(&bar);
+  free_sprite(&bush);
+  scene_free(&scene);
+  TEST_ASSERT(match, "UI differs from reference");
+}
+
+// Two views looking at opposite map vertices: background around the map, clipping at edges
+REGISTER_TEST(golden_map_edges) {
+  Scene scene;
+  TEST_ASSERT(scene_init(&scene, (Vector){0.0f, 0.0f}), "Failed to create scene");
+  VectorU32 size = map_get_size(scene.map);
+  // Isometric map is a diamond: its top and bottom vertices show the background and tile sides
+  scene.center.position = (Vector){size.x / 2.0f, 0.0f};
+  GameObject bottom = {0};
+  bottom.position = (Vector){size.x / 2.0f, (float)size.y};
+
+  engine_set_view_rect(scene.engine, 0, 0, 0, GOLDEN_W / 2, GOLDEN_H);
+  engine_snap_view(scene.engine, 0);
+  int right = engine_add_view(scene.engine, GOLDEN_W / 2, 0, GOLDEN_W / 2, GOLDEN_H, &bottom);
+  TEST_ASSERT(right > 0, "Failed to add view");
+  engine_snap_view(scene.engine, right);
+
+  bool match = golden_match("map_edges", scene_render(&scene));
+  scene_free(&scene);
+  TEST_ASSERT(match, "Map edges differ from reference");
+}
+
+// Zoomed-out main view (map mips) with zoomed-in picture-in-picture (pixel replication)
+REGISTER_TEST(golden_zoom) {
+  Scene scene;
+  TEST_ASSERT(scene_init(&scene, (Vector){0.0f, 0.0f}), "Failed to create scene");
+  scene.center.position = map_center(scene.map);
+  engine_set_zoom(scene.engine, 0.2f);
+  engine_snap_view(scene.engine, 0);
+  int pip = engine_add_view(scene.engine, GOLDEN_W - 70, GOLDEN_H - 50, 60, 40, &scene.center);
+  TEST_ASSERT(pip > 0, "Failed to add view");
+  engine_set_view_zoom(scene.engine, pip, 3.0f);
+  engine_snap_view(scene.engine, pip);
+
+  bool match = golden_match("zoom", scene_render(&scene));
+  scene_free(&scene);
+  TEST_ASSERT(match, "Zoomed views differ from reference");
+}
+
+// Full-screen secondary view covers the main one, whether the main view draws straight into the screen
+// or into its own buffer. Compared with a single view instead of a reference image.
+REGISTER_TEST(views_full_screen_overlay) {
+  Scene single, overlay;
+  TEST_ASSERT(scene_init(&single, (Vector){0.0f, 0.0f}), "Failed to create scene");
+  TEST_ASSERT(scene_init(&overlay, (Vector){0.0f, 0.0f}), "Failed to create scene");
+  GameObject far = {0};
+  far.position = map_center(single.map);
+  single.center.position = far.position;
+  engine_snap_view(single.engine, 0);
+  size_t frame_size = (size_t)GOLDEN_W * GOLDEN_H * sizeof(uint32_t);
+  uint32_t *expected = malloc(frame_size);
+  TEST_ASSERT_NOT_NULL(expected, "Allocation failed");
+  memcpy(expected, scene_render(&single), frame_size);
+
+  int top = engine_add_view(overlay.engine, 0, 0, GOLDEN_W, GOLDEN_H, &far);
+  TEST_ASSERT(top > 0, "Failed to add view");
+  engine_snap_view(overlay.engine, top);
+  bool direct_match = memcmp(scene_render(&overlay), expected, frame_size) == 0;
+  // Main view with own buffer
+  engine_set_view_rect(overlay.engine, 0, 10, 10, GOLDEN_W / 2, GOLDEN_H / 2);
+  bool buffered_match = memcmp(scene_render(&overlay), expected, frame_size) == 0;
+
+  free(expected);
+  scene_free(&single);
+  scene_free(&overlay);
+  TEST_ASSERT(direct_match, "Full-screen view should cover the full-screen main view");
+  TEST_ASSERT(buffered_match, "Full-screen view should cover the main view with own buffer");
+}
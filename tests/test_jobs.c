@@ -0,0 +1,30 @@
+#include "test_framework.h"
+#include <engine/jobs.h>
+
+#define ITEMS 10000
+
+static void mark_range(uint32_t begin, uint32_t end, uint32_t worker, void *user_data) {
+  (void)worker;
+  int *hits = (int *)user_data;
+  for (uint32_t i = begin; i < end; i++) { hits[i]++; }
+}
+
+// Every item must be processed exactly once, with and without worker threads
+REGISTER_TEST(jobs_parallel_for_covers_range) {
+  static int hits[ITEMS];
+  int worker_counts[] = {1, 4};
+
+  for (int w = 0; w < 2; w++) {
+    JobSystem *js = jobs_create(worker_counts[w]);
+    TEST_ASSERT_NOT_NULL(js, "Failed to create job system");
+
+    for (int run = 0; run < 3; run++) {
+      memset(hits, 0, sizeof(hits));
+      jobs_parallel_for(js, ITEMS, 37, mark_range, hits);
+      for (int i = 0; i < ITEMS; i++) {
+        TEST_ASSERT_EQ(hits[i], 1, "Item processed not exactly once");
+      }
+    }
+    jobs_free(js);
+  }
+}
@@ -0,0 +1,122 @@
+#include "test_framework.h"
+#include "world/map_priv.h"
+#include <engine/map.h>
+#include <engine/types.h>
+
+#define MAP_WIDTH 40
+#define MAP_HEIGHT 25
+#define POSITIONS_COUNT 1000
+
+static Map *create_test_map(void) {
+  TilesInfo ti = {0};
+  ti.tile_sprites = calloc(1, sizeof(Sprite));
+  ti.tile_sprites[0] = load_sprite("demo/assets/grass_high.png", 1.0f / 7.2f);
+  ti.sprite_count = 1;
+  ti.tiles = calloc(MAP_WIDTH * MAP_HEIGHT, sizeof(uint32_t));
+  ti.sides_height = 64;
+  return map_create(MAP_WIDTH, MAP_HEIGHT, ti);
+}
+
+// Random positions must respect the map boundaries and the margin
+REGISTER_TEST(map_random_positions_within_margin) {
+  Map *map = create_test_map();
+  TEST_ASSERT_NOT_NULL(map, "Failed to create map");
+
+  uint32_t margin = 50;
+  VectorU32 *positions = malloc(POSITIONS_COUNT * sizeof(VectorU32));
+  map_gen_random_positions(map, margin, positions, POSITIONS_COUNT);
+
+  bool all_inside = true;
+  for (int i = 0; i < POSITIONS_COUNT; i++) {
+    Vector p = {(float)positions[i].x, (float)positions[i].y};
+    if (!is_point_within_map(map, p, margin - 2)) all_inside = false;
+  }
+  VectorU32 single = map_gen_random_position(map, margin);
+  bool single_inside = is_point_within_map(map, (Vector){(float)single.x, (float)single.y}, margin - 2);
+
+  free(positions);
+  map_free(map);
+  TEST_ASSERT(all_inside, "Bulk positions must lie inside the margin-shrunk map");
+  TEST_ASSERT(single_inside, "Single position must lie inside the margin-shrunk map");
+}
+
+// Every mip level is half of the previous one, made of alpha-weighted 2x2 averages
+REGISTER_TEST(map_mip_chain_box_filter) {
+  Map *map = create_test_map();
+  TEST_ASSERT_NOT_NULL(map, "Failed to create map");
+
+  VectorU32 size = map_get_size(map);
+  uint32_t expected_count = 1;
+  for (uint32_t m = size.x > size.y ? size.x : size.y; m > 1; m = (m + 1) / 2) expected_count++;
+  TEST_ASSERT_EQ(map_mip_count(map), expected_count, "Chain should go down to 1x1");
+  TEST_ASSERT_EQ(map->mips[map->mip_count - 1].width, 1, "Last level should be 1 pixel wide");
+
+  const Sprite *l0 = &map->mips[0], *l1 = &map->mips[1];
+  TEST_ASSERT_EQ(l1->width, (l0->width + 1) / 2, "Level 1 should be half as wide");
+  bool all_match = true;
+  for (uint32_t y = 0; y < l1->height && y * 2 + 1 < l0->height; y += 7) {
+    for (uint32_t x = 0; x < l1->width && x * 2 + 1 < l0->width; x += 5) {
+      uint32_t sum_a = 0, sum_g = 0;
+      for (int k = 0; k < 4; k++) {
+        uint32_t p = l0->pixels[(y * 2 + k / 2) * l0->width + x * 2 + k % 2];
+        sum_a += p >> 24;
+        sum_g += ((p >> 8) & 0xFF) * (p >> 24);
+      }
+      uint32_t p = l1->pixels[y * l1->width + x];
+      int a = (int)(p >> 24) - (int)((sum_a + 2) / 4);
+      int g = sum_a ? (int)((p >> 8) & 0xFF) - (int)((sum_g + sum_a / 2) / sum_a) : 0;
+      if (a < -1 || a > 1 || g < -1 || g > 1) all_match = false;
+    }
+  }
+  map_free(map);
+  TEST_ASSERT(all_match, "Level 1 pixel should be the average of 2x2 block");
+}
+
+// Overview fits the map into destination keeping aspect ratio
+REGISTER_TEST(map_overview_fits_destination) {
+  Map *map = create_test_map();
+  TEST_ASSERT_NOT_NULL(map, "Failed to create map");
+  VectorU32 size = map_get_size(map);
+
+  enum { W = 120, H = 40 };
+  static uint32_t dst[W * H];
+  float scale = map_render_overview(map, dst, W, H);
+  float expected = fminf((float)W / size.x, (float)H / size.y);
+  TEST_ASSERT_FLOAT_EQ(scale, expected, 1e-6f, "Scale should fit the map");
+
+  // Map is a diamond: its center is covered, corners of the fitted rectangle are not
+  TEST_ASSERT((dst[(H / 2) * W + W / 2] >> 24) == 0xFF, "Map center should be drawn");
+  TEST_ASSERT_EQ(dst[0], 0, "Corner should stay untouched");
+  TEST_ASSERT_EQ(map_render_overview(map, dst, 0, H), 0.0f, "Empty destination should be rejected");
+  map_free(map);
+}
+
+// Baked object is drawn into the prerendered map with its shadow, and mips see it
+REGISTER_TEST(map_bake_objects_draws_into_map) {
+  Map *map = create_test_map();
+  TEST_ASSERT_NOT_NULL(map, "Failed to create map");
+  VectorU32 size = map_get_size(map);
+
+  Sprite sprite = {calloc(8 * 8, sizeof(uint32_t)), 8, 8};
+  for (int i = 0; i < 64; i++) sprite.pixels[i] = 0xFFFF0000;
+  GameObject obj = {0};
+  obj.position = (Vector){(float)(size.x / 2), (float)(size.y / 2)};
+  obj.cur_sprite = &sprite;
+  GameObject *objs[1] = {&obj};
+
+  uint32_t x = size.x / 2, y = size.y / 2;
+  uint32_t shadow_before = map->pixels[y * size.x + x + 9];
+  uint32_t mip_before = map->mips[1].pixels[(y / 2) * map->mips[1].width + x / 2];
+  TEST_ASSERT(map_bake_objects(map, objs, 1), "Baking failed");
+
+  uint32_t pixel = map->pixels[(y + 3) * size.x + x + 3];
+  uint32_t shadow = map->pixels[y * size.x + x + 9];
+  uint32_t mip_after = map->mips[1].pixels[(y / 2) * map->mips[1].width + x / 2];
+  TEST_ASSERT_EQ(map_mip_count(map), map->mip_count, "Mip chain should be rebuilt");
+  map_free(map);
+  free_sprite(&sprite);
+
+  TEST_ASSERT_EQ(pixel, 0xFFFF0000, "Object pixel should be in the map");
+  TEST_ASSERT(((shadow >> 8) & 0xFF) < ((shadow_before >> 8) & 0xFF), "Shadow should darken the map");
+  TEST_ASSERT(mip_after != mip_before, "Mip level should include baked object");
+}
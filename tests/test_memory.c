@@ -0,0 +1,127 @@
+#include "test_framework.h"
+#include <engine/engine.h>
+#include <engine/entity.h>
+#include <engine/memory.h>
+#include <engine/types.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Other tests may leave buffers alive, so only changes of the counters are checked
+
+REGISTER_TEST(memory_counts_by_category) {
+  MemoryUsage before = memory_get_usage(MEMORY_UI);
+  MemoryStats total_before = memory_get_stats();
+
+  void *a = memory_alloc(MEMORY_UI, 100);
+  uint32_t *b = memory_calloc(MEMORY_UI, 10, sizeof(uint32_t));
+  TEST_ASSERT(a && b, "Allocation failed");
+  TEST_ASSERT_EQ(b[9], 0, "memory_calloc memory should be zeroed");
+  MemoryUsage usage = memory_get_usage(MEMORY_UI);
+  TEST_ASSERT_EQ(usage.current - before.current, 140, "Both buffers should be counted");
+  TEST_ASSERT_EQ(usage.blocks - before.blocks, 2, "Block count mismatch");
+  TEST_ASSERT_EQ(memory_get_stats().current - total_before.current, 140, "Total should include buffers");
+
+  b = memory_realloc(MEMORY_UI, b, 1000);
+  TEST_ASSERT_NOT_NULL(b, "Reallocation failed");
+  usage = memory_get_usage(MEMORY_UI);
+  TEST_ASSERT_EQ(usage.current - before.current, 1100, "Reallocated buffer should be counted with new size");
+  TEST_ASSERT_EQ(usage.blocks - before.blocks, 2, "Reallocation should not add blocks");
+
+  memory_free(a);
+  memory_free(b);
+  usage = memory_get_usage(MEMORY_UI);
+  TEST_ASSERT_EQ(usage.current, before.current, "Freed buffers should not be counted");
+  TEST_ASSERT_EQ(usage.blocks, before.blocks, "Block count mismatch");
+  TEST_ASSERT(usage.peak >= before.current + 1100, "Peak should keep the highest usage");
+  TEST_ASSERT_EQ(strcmp(memory_category_name(MEMORY_UI), "ui"), 0, "Category name mismatch");
+}
+
+REGISTER_TEST(memory_ignores_untracked_buffers) {
+  MemoryStats before = memory_get_stats();
+  // Sprite made by the caller and freed by the engine
+  Sprite sprite = {malloc(16 * sizeof(uint32_t)), 4, 4};
+  free_sprite(&sprite);
+  TEST_ASSERT_EQ(memory_get_stats().current, before.current, "Untracked buffers should not change counters");
+
+  // Adopted buffer is counted until it is untracked
+  void *adopted = malloc(64);
+  memory_track(MEMORY_MAP, adopted, 64);
+  memory_track(MEMORY_MAP, adopted, 32);
+  TEST_ASSERT_EQ(memory_get_usage(MEMORY_MAP).current - before.categories[MEMORY_MAP].current, 32,
+      "Tracking again should replace the size");
+  memory_untrack(adopted);
+  TEST_ASSERT_EQ(memory_get_usage(MEMORY_MAP).current, before.categories[MEMORY_MAP].current,
+      "Untracked buffer should not be counted");
+  free(adopted);
+}
+
+// Failed reallocation keeps the old buffer counted as before, not as a new allocation
+REGISTER_TEST(memory_failed_realloc_keeps_counters) {
+  void *buf = memory_alloc(MEMORY_UI, 64);
+  TEST_ASSERT_NOT_NULL(buf, "Allocation failed");
+  MemoryUsage before = memory_get_usage(MEMORY_UI);
+  MemoryStats total_before = memory_get_stats();
+
+  // No allocator can serve that
+  void *grown = memory_realloc(MEMORY_UI, buf, (size_t)PTRDIFF_MAX);
+  MemoryUsage usage = memory_get_usage(MEMORY_UI);
+  MemoryStats total = memory_get_stats();
+  memory_free(grown ? grown : buf);
+
+  TEST_ASSERT_NULL(grown, "Reallocation should fail");
+  TEST_ASSERT_EQ(usage.current, before.current, "Old buffer should stay counted");
+  TEST_ASSERT_EQ(usage.blocks, before.blocks, "Block count mismatch");
+  TEST_ASSERT_EQ(usage.allocations, before.allocations, "Failed reallocation is not an allocation");
+  TEST_ASSERT_EQ(usage.peak, before.peak, "Peak should not change");
+  TEST_ASSERT_EQ(total.peak, total_before.peak, "Total peak should not change");
+}
+
+// Many live buffers force the address table to grow and shift entries on removal
+REGISTER_TEST(memory_tracks_many_buffers) {
+  enum { COUNT = 2000 };
+  MemoryUsage before = memory_get_usage(MEMORY_TEXT);
+  void **buffers = malloc(COUNT * sizeof(void *));
+  for (int i = 0; i < COUNT; i++) buffers[i] = memory_alloc(MEMORY_TEXT, (size_t)i + 1);
+  MemoryUsage usage = memory_get_usage(MEMORY_TEXT);
+  TEST_ASSERT_EQ(usage.blocks - before.blocks, COUNT, "All buffers should be tracked");
+  TEST_ASSERT_EQ(usage.current - before.current, (size_t)COUNT * (COUNT + 1) / 2, "Size sum mismatch");
+
+  // Free every second buffer, then the rest
+  for (int i = 0; i < COUNT; i += 2) memory_free(buffers[i]);
+  for (int i = 1; i < COUNT; i += 2) memory_free(buffers[i]);
+  usage = memory_get_usage(MEMORY_TEXT);
+  free(buffers);
+  TEST_ASSERT_EQ(usage.blocks, before.blocks, "All buffers should be released");
+  TEST_ASSERT_EQ(usage.current, before.current, "All bytes should be released");
+}
+
+REGISTER_TEST(memory_accounts_engine_subsystems) {
+  MemoryStats before = memory_get_stats();
+  Engine *engine = engine_create_headless(64, 32);
+  EntityStore *store = entity_store_create(100, 0);
+  TEST_ASSERT(engine && store, "Failed to create engine");
+
+  MemoryStats stats = memory_get_stats();
+  size_t render = stats.categories[MEMORY_RENDER].current - before.categories[MEMORY_RENDER].current;
+  TEST_ASSERT(render >= 64 * 32 * sizeof(uint32_t) + ENGINE_FRAME_ARENA_SIZE,
+      "Framebuffer and frame arena should be counted as render memory");
+  size_t entities = stats.categories[MEMORY_ENTITIES].current - before.categories[MEMORY_ENTITIES].current;
+  TEST_ASSERT(entities >= 100 * (sizeof(GameObject) + 2 * sizeof(Vector)), "Entity arrays should be counted");
+
+  char report[1024] = {0};
+  FILE *out = tmpfile();
+  TEST_ASSERT_NOT_NULL(out, "Failed to create temporary file");
+  engine_set_memory_dump(engine, out, 0);
+  engine_end_frame(engine);
+  rewind(out);
+  size_t read = fread(report, 1, sizeof(report) - 1, out);
+  fclose(out);
+  engine_set_memory_dump(engine, NULL, 0);
+  TEST_ASSERT(read > 0 && strstr(report, "render") && strstr(report, "total"), "Dump should list categories");
+
+  entity_store_free(store);
+  engine_free(engine);
+  stats = memory_get_stats();
+  TEST_ASSERT_EQ(stats.current, before.current, "Everything should be released with its owner");
+}
@@ -0,0 +1,40 @@
+#include "test_framework.h"
+#include <engine/noise.h>
+
+#define ROW_LEN 300
+#define EPSILON 0.0001f
+
+// Row evaluation must match point sampling and stay in [0, 1]
+REGISTER_TEST(noise_row_matches_sample) {
+  NoiseType types[] = {NOISE_VALUE, NOISE_GRADIENT, NOISE_SIMPLEX};
+  for (int t = 0; t < 3; t++) {
+    NoiseParams params = noise_default_params(types[t], 1234);
+    float row[ROW_LEN];
+    noise_fill_row(&params, -10.0f, 3.5f, 0.75f, row, ROW_LEN);
+
+    for (int i = 0; i < ROW_LEN; i++) {
+      TEST_ASSERT(row[i] >= 0.0f && row[i] <= 1.0f, "Noise out of [0, 1]");
+      float s = noise_sample(&params, -10.0f + i * 0.75f, 3.5f);
+      TEST_ASSERT_FLOAT_EQ(row[i], s, EPSILON, "Row value differs from single sample");
+    }
+  }
+}
+
+// Tiles are filled with valid sprite indices following the thresholds
+REGISTER_TEST(noise_fill_tiles_indices) {
+  TilesInfo ti = {0};
+  ti.sprite_count = 3;
+  float thresholds[] = {0.4f, 0.6f};
+  NoiseParams params = noise_default_params(NOISE_GRADIENT, 5);
+
+  TEST_ASSERT(noise_fill_tiles(&params, &ti, 64, 32, thresholds), "Failed to fill tiles");
+  TEST_ASSERT_NOT_NULL(ti.tiles, "Tiles must be allocated");
+
+  int seen[3] = {0};
+  for (int i = 0; i < 64 * 32; i++) {
+    TEST_ASSERT(ti.tiles[i] < 3, "Tile index out of range");
+    seen[ti.tiles[i]]++;
+  }
+  free(ti.tiles);
+  TEST_ASSERT(seen[0] > 0 && seen[2] > 0, "Noise must produce different tiles");
+}
@@ -0,0 +1,74 @@
+#include "test_framework.h"
+#include <engine/object_pool.h>
+
+typedef struct {
+  int id;
+  float value;
+} Item;
+
+REGISTER_TEST(object_pool_alloc_get_release) {
+  ObjectPool *pool = OBJECT_POOL_CREATE(Item, 2);
+  TEST_ASSERT_NOT_NULL(pool, "Failed to create pool");
+
+  Handle handles[5];
+  for (int i = 0; i < 5; i++) {
+    Item *item = NULL;
+    handles[i] = object_pool_alloc(pool, (void **)&item);
+    TEST_ASSERT_NOT_NULL(item, "Allocation failed");
+    TEST_ASSERT_EQ(item->id, 0, "New item should be zeroed");
+    item->id = i;
+  }
+  TEST_ASSERT_EQ(object_pool_count(pool), 5, "Pool should grow past initial capacity");
+
+  // Handles survive growth and removal of other items
+  TEST_ASSERT(object_pool_release(pool, handles[1]), "Release failed");
+  TEST_ASSERT(object_pool_release(pool, handles[3]), "Release failed");
+  TEST_ASSERT_EQ(object_pool_count(pool), 3, "Count after release");
+  for (int i = 0; i < 5; i++) {
+    Item *item = OBJECT_POOL_GET(pool, Item, handles[i]);
+    if (i == 1 || i == 3) {
+      TEST_ASSERT_NULL(item, "Released handle should be stale");
+    } else {
+      TEST_ASSERT_NOT_NULL(item, "Live handle should resolve");
+      TEST_ASSERT_EQ(item->id, i, "Handle should resolve to its own item");
+    }
+  }
+  TEST_ASSERT(!object_pool_release(pool, handles[1]), "Double release should fail");
+
+  // Slot is reused with a new generation, old handle stays stale
+  Handle reused = object_pool_alloc(pool, NULL);
+  TEST_ASSERT(reused.index == handles[3].index, "Last freed slot should be reused");
+  TEST_ASSERT(!handle_equal(reused, handles[3]), "Reused slot should have new generation");
+  TEST_ASSERT_NULL(object_pool_get(pool, handles[3]), "Old handle should stay stale");
+  TEST_ASSERT_NULL(object_pool_get(pool, HANDLE_NONE), "Zero handle is never valid");
+
+  object_pool_free(pool);
+}
+
+// Live items are packed and iteration sees each of them once
+REGISTER_TEST(object_pool_iteration_is_dense) {
+  ObjectPool *pool = OBJECT_POOL_CREATE(Item, 8);
+  Handle handles[8];
+  for (int i = 0; i < 8; i++) {
+    Item *item = NULL;
+    handles[i] = object_pool_alloc(pool, (void **)&item);
+    item->id = i;
+  }
+  for (int i = 0; i < 8; i += 2) object_pool_release(pool, handles[i]);
+
+  Item *items = OBJECT_POOL_ITEMS(pool, Item);
+  int seen = 0;
+  for (uint32_t i = 0; i < object_pool_count(pool); i++) {
+    TEST_ASSERT(items[i].id % 2 == 1, "Only live items should be iterated");
+    seen |= 1 << items[i].id;
+    Handle h = object_pool_handle_at(pool, i);
+    TEST_ASSERT(OBJECT_POOL_GET(pool, Item, h) == &items[i], "Handle at index should resolve back");
+  }
+  TEST_ASSERT_EQ(seen, 0xAA, "Every live item should be iterated once");
+
+  object_pool_clear(pool);
+  TEST_ASSERT_EQ(object_pool_count(pool), 0, "Clear should remove everything");
+  TEST_ASSERT_NULL(object_pool_get(pool, handles[1]), "Clear should invalidate handles");
+
+  object_pool_free(pool);
+}
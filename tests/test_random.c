@@ -0,0 +1,45 @@
+#include "test_framework.h"
+#include <engine/random.h>
+
+#define SEQ_LEN 64
+
+// Same seed must produce the same sequence
+REGISTER_TEST(rng_reproducible) {
+  Rng a, b;
+  rng_seed(&a, 12345);
+  rng_seed(&b, 12345);
+  for (int i = 0; i < SEQ_LEN; i++) { TEST_ASSERT_EQ(rng_next(&a), rng_next(&b), "Sequences differ"); }
+
+  rand_seed(42);
+  uint32_t first = rand_big();
+  rand_seed(42);
+  TEST_ASSERT_EQ(rand_big(), first, "rand_big must be reproducible after rand_seed");
+}
+
+// Split streams must differ from each other and from the parent
+REGISTER_TEST(rng_split_streams) {
+  Rng parent;
+  rng_seed(&parent, 7);
+  Rng s1 = rng_split(&parent);
+  Rng s2 = rng_split(&parent);
+
+  int same = 0;
+  for (int i = 0; i < SEQ_LEN; i++) {
+    uint32_t a = rng_next(&s1), b = rng_next(&s2), c = rng_next(&parent);
+    if (a == b || b == c || a == c) same++;
+  }
+  TEST_ASSERT(same < 2, "Split streams must be independent");
+}
+
+// Bulk and ranged values stay in their bounds
+REGISTER_TEST(rng_bounds) {
+  Rng rng;
+  rng_seed(&rng, 99);
+  float values[SEQ_LEN];
+  rng_fill_float01(&rng, values, SEQ_LEN);
+  for (int i = 0; i < SEQ_LEN; i++) {
+    TEST_ASSERT(values[i] >= 0.0f && values[i] < 1.0f, "Float out of [0, 1)");
+    TEST_ASSERT(rng_range(&rng, 10) < 10, "Range out of bounds");
+  }
+  TEST_ASSERT_EQ(rng_range(&rng, 0), 0, "Zero bound must return 0");
+}
@@ -0,0 +1,147 @@
+#include "graphics/camera.h"
+#include "graphics/render.h"
+#include "test_framework.h"
+#include <engine/render_list.h>
+#include <engine/types.h>
+
+#define VIEW_W 48
+#define VIEW_H 32
+#define OBJ_COUNT 30
+
+// Views rendered from shared sorted and bounded objects must look exactly like separate rendering
+REGISTER_TEST(render_views_share_prepared_objects) {
+  Sprite sprite = {calloc(6 * 10, sizeof(uint32_t)), 6, 10};
+  for (int i = 0; i < 60; i++) sprite.pixels[i] = (i % 7) ? 0xFF000000 | (i * 40503u) : 0;
+
+  GameObject objs[OBJ_COUNT] = {0};
+  GameObject *ptrs[OBJ_COUNT];
+  for (int i = 0; i < OBJ_COUNT; i++) {
+    objs[i].position = (Vector){(float)((i * 37) % 150) - 20.0f, (float)((i * 23) % 90) - 10.0f};
+    objs[i].prev_position = (Vector){objs[i].position.x - 3.0f, objs[i].position.y + 1.0f};
+    objs[i].interpolate = (i % 2) == 0;
+    objs[i].cur_sprite = &sprite;
+    ptrs[i] = &objs[i];
+  }
+  RenderBatch batch = {0};
+  batch.objs = ptrs;
+  batch.obj_count = OBJ_COUNT;
+
+  Camera *cameras[3] = {camera_create(VIEW_W, VIEW_H), camera_create(VIEW_W, VIEW_H), camera_create(20, 20)};
+  cameras[1]->position = (Vector){60.0f, 30.5f};
+  camera_set_zoom(cameras[1], 0.5f);
+  cameras[2]->position = (Vector){-5.0f, 40.0f};
+  camera_set_zoom(cameras[2], 2.0f);
+
+  RenderShared shared = {0};
+  Arena *arena = arena_create(64);
+  float alpha = 0.25f;
+  TEST_ASSERT(render_prepare_objects(&shared, &batch, arena, alpha), "Failed to prepare objects");
+  TEST_ASSERT_EQ(shared.count, OBJ_COUNT, "Every object should be bounded");
+
+  static uint32_t separate[VIEW_W * VIEW_H], shared_fb[VIEW_W * VIEW_H];
+  for (int c = 0; c < 3; c++) {
+    for (int i = 0; i < VIEW_W * VIEW_H; i++) separate[i] = shared_fb[i] = 0xFF336699;
+    render_batch(separate, &batch, cameras[c], alpha);
+    render_view_objects(shared_fb, &batch, &shared, cameras[c], alpha);
+    for (int i = 0; i < VIEW_W * VIEW_H; i++) {
+      TEST_ASSERT_EQ(shared_fb[i], separate[i], "Culled view differs from full rendering");
+    }
+  }
+
+  arena_free(arena);
+  for (int c = 0; c < 3; c++) camera_free(cameras[c]);
+  free_sprite(&sprite);
+}
+
+// Static objects kept sorted in render list and merged with dynamic ones must look exactly like
+// all objects sorted together
+REGISTER_TEST(render_list_merges_static_and_dynamic) {
+  Sprite sprite = {calloc(6 * 10, sizeof(uint32_t)), 6, 10};
+  for (int i = 0; i < 60; i++) sprite.pixels[i] = (i % 5) ? 0xFF000000 | (i * 2654435761u) : 0;
+
+  // Different depths, so draw order doesn't depend on sort stability
+  GameObject objs[OBJ_COUNT] = {0};
+  GameObject *ptrs[OBJ_COUNT];
+  for (int i = 0; i < OBJ_COUNT; i++) {
+    objs[i].position = (Vector){(float)((i * 13) % 40), (float)i * 0.75f};
+    objs[i].cur_sprite = &sprite;
+    ptrs[i] = &objs[i];
+  }
+
+  RenderList *list = render_list_create();
+  TEST_ASSERT_NOT_NULL(list, "Failed to create render list");
+  Handle handles[OBJ_COUNT];
+  for (int i = 0; i < OBJ_COUNT; i++) {
+    handles[i] = i % 3 ? render_list_add_static(list, &objs[i]) : render_list_add(list, &objs[i]);
+  }
+  // Removed objects are not drawn
+  render_list_remove_static(list, handles[1]);
+  render_list_remove(list, handles[3]);
+  TEST_ASSERT_EQ(render_list_count(list), OBJ_COUNT - 2, "Count after removal");
+
+  RenderBatch all = {0}, listed = {0};
+  uint32_t n = 0;
+  for (int i = 0; i < OBJ_COUNT; i++) {
+    if (i != 1 && i != 3) ptrs[n++] = &objs[i];
+  }
+  all.objs = ptrs;
+  all.obj_count = n;
+  listed.render_list = list;
+
+  Camera *camera = camera_create(VIEW_W, VIEW_H);
+  static uint32_t expected[VIEW_W * VIEW_H], actual[VIEW_W * VIEW_H];
+  for (int frame = 0; frame < 2; frame++) {
+    // Dynamic objects move between frames, static partition stays as is
+    for (int i = 0; i < OBJ_COUNT; i += 3) objs[i].position.y += 7.0f;
+    for (int i = 0; i < VIEW_W * VIEW_H; i++) expected[i] = actual[i] = 0xFF336699;
+    render_batch(expected, &all, camera, 1.0f);
+    render_batch(actual, &listed, camera, 1.0f);
+    for (int i = 0; i < VIEW_W * VIEW_H; i++) {
+      TEST_ASSERT_EQ(actual[i], expected[i], "Merged rendering differs from full sort");
+    }
+  }
+
+  render_list_free(list);
+  camera_free(camera);
+  free_sprite(&sprite);
+}
+
+// Objects are drawn between their previous and current logic step positions
+REGISTER_TEST(render_object_draw_position_interpolates) {
+  GameObject obj = {0};
+  obj.prev_position = (Vector){10.0f, -4.0f};
+  obj.position = (Vector){20.0f, 8.0f};
+  obj.interpolate = true;
+  Vector pos = object_draw_position(&obj, 0.0f);
+  TEST_ASSERT_VECTOR2_EQ(pos, obj.prev_position, 1e-5f, "Alpha 0 - previous step");
+  pos = object_draw_position(&obj, 1.0f);
+  TEST_ASSERT_VECTOR2_EQ(pos, obj.position, 1e-5f, "Alpha 1 - current step");
+  pos = object_draw_position(&obj, 0.5f);
+  TEST_ASSERT_VECTOR2_EQ(pos, ((Vector){15.0f, 2.0f}), 1e-5f, "Alpha 0.5 - midway");
+
+  obj.interpolate = false;
+  pos = object_draw_position(&obj, 0.5f);
+  TEST_ASSERT_VECTOR2_EQ(pos, obj.position, 1e-5f, "Without interpolation - current step");
+}
+
+REGISTER_TEST(camera_interpolate_lerps_position) {
+  Camera *camera = camera_create(VIEW_W, VIEW_H);
+  TEST_ASSERT_NOT_NULL(camera, "Failed to create camera");
+  camera->position = (Vector){-6.0f, 4.0f};
+  camera_snap(camera);
+  camera->target = (Vector){100.0f, 50.0f};
+  Vector before = camera->position;
+  camera_update(camera, 1.0f / 30.0f);
+  TEST_ASSERT_VECTOR2_EQ(camera->prev_position, before, 1e-5f, "Update should keep the previous position");
+
+  Camera view = camera_interpolate(camera, 0.0f);
+  TEST_ASSERT_VECTOR2_EQ(view.position, before, 1e-5f, "Alpha 0 - previous position");
+  view = camera_interpolate(camera, 1.0f);
+  TEST_ASSERT_VECTOR2_EQ(view.position, camera->position, 1e-5f, "Alpha 1 - current position");
+  view = camera_interpolate(camera, 0.25f);
+  Vector quarter = {before.x + (camera->position.x - before.x) * 0.25f,
+      before.y + (camera->position.y - before.y) * 0.25f};
+  TEST_ASSERT_VECTOR2_EQ(view.position, quarter, 1e-4f, "Alpha 0.25 - quarter way");
+  TEST_ASSERT_VECTOR2_EQ(view.size, camera->size, 1e-5f, "Only position is interpolated");
+  camera_free(camera);
+}
@@ -0,0 +1,124 @@
+#include "test_framework.h"
+#include <engine/engine.h>
+#include <engine/replay.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define TICKS 100
+
+// Input of tick i: keys change every few ticks, so runs of different length are recorded
+static Input tick_input(int i) {
+  Input input = {0};
+  input.w = (i / 7) % 2;
+  input.d = (i / 3) % 2;
+  input.lshift = i > 50;
+  return input;
+}
+
+REGISTER_TEST(input_pack_roundtrip) {
+  Input input = {0};
+  input.up = input.m = input.space = input.lshift = true;
+  uint64_t bits = input_pack(&input);
+  Input back = input_unpack(bits);
+  TEST_ASSERT_EQ(input_pack(&back), bits, "Unpacked input should pack to the same bits");
+  TEST_ASSERT(back.up && back.m && back.space && back.lshift, "Pressed keys should survive");
+  TEST_ASSERT(!back.down && !back.a, "Released keys should stay released");
+  TEST_ASSERT_EQ(input_pack(&(Input){0}), 0, "No keys - no bits");
+}
+
+REGISTER_TEST(replay_save_load_roundtrip) {
+  Replay *rec = replay_create(0x1234567890ABCDEFull, 50.0f);
+  TEST_ASSERT_NOT_NULL(rec, "Failed to create replay");
+  for (int i = 0; i < TICKS; i++) {
+    Input input = tick_input(i);
+    TEST_ASSERT(replay_record(rec, &input), "Recording failed");
+  }
+  TEST_ASSERT_EQ(replay_tick_count(rec), TICKS, "Tick count mismatch");
+
+  const char *path = "test_replay.tmp";
+  TEST_ASSERT(replay_save(rec, path), "Saving failed");
+  Replay *loaded = replay_load(path);
+  remove(path);
+  TEST_ASSERT_NOT_NULL(loaded, "Loading failed");
+
+  TEST_ASSERT(replay_seed(loaded) == 0x1234567890ABCDEFull, "Seed should be stored");
+  TEST_ASSERT_FLOAT_EQ(replay_tick_rate(loaded), 50.0f, 1e-6f, "Tick rate should be stored");
+  TEST_ASSERT_EQ(replay_tick_count(loaded), TICKS, "Tick count should be stored");
+  for (int i = 0; i < TICKS; i++) {
+    Input input, expected = tick_input(i);
+    TEST_ASSERT(replay_next(loaded, &input), "Replay ended too early");
+    TEST_ASSERT_EQ(input_pack(&input), input_pack(&expected), "Replayed input differs");
+  }
+  TEST_ASSERT(!replay_next(loaded, NULL), "Replay should end after the last tick");
+
+  replay_rewind(loaded);
+  Input first;
+  TEST_ASSERT(replay_next(loaded, &first), "Rewound replay should start again");
+  TEST_ASSERT_EQ(input_pack(&first), input_pack(&(Input){0}), "First tick after rewind");
+
+  replay_free(loaded);
+  replay_free(rec);
+}
+
+// Run count in the header is checked against the file size before anything is allocated
+REGISTER_TEST(replay_load_rejects_bad_run_count) {
+  const char *path = "test_replay_bad.tmp";
+  Replay *rec = replay_create(7, 30.0f);
+  Input input = tick_input(0);
+  TEST_ASSERT(rec && replay_record(rec, &input), "Recording failed");
+  TEST_ASSERT(replay_save(rec, path), "Saving failed");
+  replay_free(rec);
+
+  // Run count is the last field of the 24-byte header
+  const uint32_t counts[] = {0x80000001u, 0xFFFFFFFFu, 1000000u, 2u};
+  for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+    FILE *f = fopen(path, "r+b");
+    TEST_ASSERT_NOT_NULL(f, "Failed to open replay");
+    uint8_t b[4] = {(uint8_t)counts[i], (uint8_t)(counts[i] >> 8), (uint8_t)(counts[i] >> 16),
+        (uint8_t)(counts[i] >> 24)};
+    fseek(f, 20, SEEK_SET);
+    fwrite(b, 1, 4, f);
+    fclose(f);
+    Replay *loaded = replay_load(path);
+    replay_free(loaded);
+    TEST_ASSERT(loaded == NULL, "Run count beyond the file size should be rejected");
+  }
+  remove(path);
+}
+
+typedef struct {
+  int ticks;
+  uint64_t checksum;
+} ReplayRun;
+
+static void replay_update(Input *input, void *user_data) {
+  ReplayRun *run = (ReplayRun *)user_data;
+  run->checksum = run->checksum * 31 + input_pack(input);
+  run->ticks++;
+}
+
+// Headless engine runs every recorded tick once, with recorded input, and stops at the end
+REGISTER_TEST(engine_replays_headless) {
+  Replay *rec = replay_create(1, 30.0f);
+  uint64_t expected = 0;
+  for (int i = 0; i < TICKS; i++) {
+    Input input = tick_input(i);
+    replay_record(rec, &input);
+    expected = expected * 31 + input_pack(&input);
+  }
+
+  Engine *engine = engine_create_headless(64, 48);
+  TEST_ASSERT_NOT_NULL(engine, "Failed to create headless engine");
+  TEST_ASSERT(engine_play_replay(engine, rec), "Replay should be accepted");
+  TEST_ASSERT_FLOAT_EQ(engine_get_tick_step(engine), 1.0f / 30.0f, 1e-6f, "Tick rate should follow replay");
+
+  ReplayRun run = {0};
+  int frames = 0;
+  while (engine_begin_frame(engine, replay_update, &run) && frames < TICKS * 2) frames++;
+  engine_free(engine);
+  replay_free(rec);
+
+  TEST_ASSERT_EQ(frames, TICKS, "Headless engine should run one tick per frame");
+  TEST_ASSERT_EQ(run.ticks, TICKS, "Every recorded tick should run");
+  TEST_ASSERT(run.checksum == expected, "Ticks should get recorded input in order");
+}
@@ -0,0 +1,94 @@
+#include "graphics/camera.h"
+#include "graphics/scale.h"
+#include "test_framework.h"
+#include <engine/types.h>
+
+#define FB_W 40
+#define FB_H 30
+
+// Opaque sprite with unique color of every pixel
+static Sprite make_pattern(uint32_t w, uint32_t h) {
+  Sprite sprite = {calloc(w * h, sizeof(uint32_t)), w, h};
+  for (uint32_t i = 0; i < w * h; i++) sprite.pixels[i] = 0xFF000000 | (i * 2654435761u >> 8);
+  return sprite;
+}
+
+// Every framebuffer pixel must equal source pixel (x - ox) / zoom, (y - oy) / zoom or stay untouched.
+// Integer zoom divides exactly, fractional zoom uses the same 16.16 fixed point as the resampler.
+static bool check_nearest(const uint32_t *fb, const Sprite *sprite, int ox, int oy, float zoom) {
+  int w = (int)scaled_size(sprite->width, zoom), h = (int)scaled_size(sprite->height, zoom);
+  uint64_t step = (uint64_t)lroundf(SCALE_FP_ONE / zoom);
+  for (int y = 0; y < FB_H; y++) {
+    for (int x = 0; x < FB_W; x++) {
+      int dx = x - ox, dy = y - oy;
+      uint32_t expected = 0xFF000000;
+      if (dx >= 0 && dy >= 0 && dx < w && dy < h) {
+        uint32_t sx = (uint32_t)((dx * step) >> SCALE_FP_SHIFT);
+        uint32_t sy = (uint32_t)((dy * step) >> SCALE_FP_SHIFT);
+        if (zoom == floorf(zoom)) {
+          sx = (uint32_t)dx / (uint32_t)zoom;
+          sy = (uint32_t)dy / (uint32_t)zoom;
+        }
+        if (sx >= sprite->width) sx = sprite->width - 1;
+        if (sy >= sprite->height) sy = sprite->height - 1;
+        expected = sprite->pixels[sy * sprite->width + sx];
+      }
+      if (fb[y * FB_W + x] != expected) return false;
+    }
+  }
+  return true;
+}
+
+// Copy, replication and resampling paths, including clipping on every side
+REGISTER_TEST(blit_scaled_nearest_neighbour) {
+  Sprite sprite = make_pattern(12, 10);
+  static uint32_t fb[FB_W * FB_H];
+  float zooms[] = {1.0f, 2.0f, 3.0f, 0.5f, 1.5f, 0.3f};
+  int offsets[][2] = {{5, 4}, {-7, -3}, {FB_W - 6, FB_H - 5}, {-50, 0}};
+
+  for (int z = 0; z < 6; z++) {
+    for (int o = 0; o < 4; o++) {
+      for (int i = 0; i < FB_W * FB_H; i++) fb[i] = 0xFF000000;
+      blit_scaled(fb, FB_W, FB_H, &sprite, offsets[o][0], offsets[o][1], zooms[z]);
+      TEST_ASSERT(check_nearest(fb, &sprite, offsets[o][0], offsets[o][1], zooms[z]),
+          "Scaled sprite differs from nearest-neighbour reference");
+    }
+  }
+  free_sprite(&sprite);
+}
+
+// Transparent pixels keep destination, semi-transparent are blended
+REGISTER_TEST(blit_scaled_blends_alpha) {
+  Sprite sprite = {calloc(2, sizeof(uint32_t)), 2, 1};
+  sprite.pixels[0] = 0x00FFFFFF;
+  sprite.pixels[1] = 0x80FFFFFF;
+  static uint32_t fb[FB_W * FB_H];
+  for (int i = 0; i < FB_W * FB_H; i++) fb[i] = 0xFF000000;
+
+  blit_scaled(fb, FB_W, FB_H, &sprite, 0, 0, 2.0f);
+  TEST_ASSERT_EQ(fb[0], 0xFF000000, "Transparent pixel should be skipped");
+  TEST_ASSERT_EQ(fb[FB_W + 1], 0xFF000000, "Transparent pixel should be skipped");
+  TEST_ASSERT(fb[2] != 0xFF000000 && fb[2] != 0xFFFFFFFF, "Semi-transparent pixel should be blended");
+  TEST_ASSERT_EQ(fb[2], fb[FB_W + 3], "Replicated pixels should be equal");
+  TEST_ASSERT_EQ(fb[4], 0xFF000000, "Nothing should be drawn after sprite");
+  free_sprite(&sprite);
+}
+
+// Zoom changes scale of world-to-screen mapping but keeps screen center in place
+REGISTER_TEST(camera_zoom_keeps_center) {
+  Camera *camera = camera_create(200, 100);
+  camera->position = (Vector){30, 40};
+  Vector center = camera_screen_to_world(camera, (Vector){100, 50});
+
+  camera_set_zoom(camera, 2.5f);
+  Vector new_center = camera_screen_to_world(camera, (Vector){100, 50});
+  TEST_ASSERT_VECTOR2_EQ(center, new_center, 1e-3f, "Center should stay in place");
+
+  Vector a = camera_world_to_screen(camera, (Vector){10, 10});
+  Vector b = camera_world_to_screen(camera, (Vector){14, 10});
+  TEST_ASSERT_FLOAT_EQ(b.x - a.x, 10.0f, 1e-3f, "World distance should be multiplied by zoom");
+
+  Vector back = camera_screen_to_world(camera, a);
+  TEST_ASSERT_VECTOR2_EQ(back, ((Vector){10, 10}), 1e-3f, "Conversions should be inverse");
+  camera_free(camera);
+}
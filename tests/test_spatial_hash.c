@@ -0,0 +1,71 @@
+#include "test_framework.h"
+#include <engine/spatial_hash.h>
+
+#define POINTS 500
+
+// Radius and rect queries must match brute force search
+REGISTER_TEST(spatial_hash_matches_brute_force) {
+  Vector points[POINTS];
+  for (int i = 0; i < POINTS; i++) {
+    points[i] = (Vector){(float)((i * 37) % 400) - 50.0f, (float)((i * 91) % 300)};
+  }
+
+  SpatialHash *sh = spatial_hash_create(25.0f, 10);
+  TEST_ASSERT_NOT_NULL(sh, "Failed to create spatial hash");
+  spatial_hash_build(sh, points, POINTS);
+
+  uint32_t found[POINTS];
+  Vector center = {100.0f, 120.0f};
+  float radius = 60.0f;
+  uint32_t n = spatial_hash_query_radius(sh, center, radius, found, POINTS);
+  int expected = 0;
+  for (int i = 0; i < POINTS; i++) {
+    float dx = points[i].x - center.x, dy = points[i].y - center.y;
+    if (dx * dx + dy * dy <= radius * radius) expected++;
+  }
+  bool all_near = true;
+  for (uint32_t k = 0; k < n; k++) {
+    float dx = points[found[k]].x - center.x, dy = points[found[k]].y - center.y;
+    if (dx * dx + dy * dy > radius * radius) all_near = false;
+  }
+
+  Rect rect = {{-40.0f, 10.0f}, 90.0f, 50.0f};
+  uint32_t rn = spatial_hash_query_rect(sh, rect, found, POINTS);
+  int rect_expected = 0;
+  for (int i = 0; i < POINTS; i++) {
+    Vector p = points[i];
+    if (p.x >= rect.pos.x && p.x <= rect.pos.x + rect.w && p.y >= rect.pos.y && p.y <= rect.pos.y + rect.h) {
+      rect_expected++;
+    }
+  }
+  spatial_hash_free(sh);
+
+  TEST_ASSERT_EQ((int)n, expected, "Radius query count differs from brute force");
+  TEST_ASSERT(all_near, "Radius query returned far point");
+  TEST_ASSERT_EQ((int)rn, rect_expected, "Rect query count differs from brute force");
+}
+
+// Huge query areas and far-away positions are answered by a scan instead of visiting every cell
+REGISTER_TEST(spatial_hash_handles_huge_areas) {
+  Vector points[4] = {{10.0f, 10.0f}, {-3e9f, 5.0f}, {1e30f, -1e30f}, {40.0f, 12.0f}};
+  SpatialHash *sh = spatial_hash_create(8.0f, 4);
+  TEST_ASSERT_NOT_NULL(sh, "Failed to create spatial hash");
+  spatial_hash_build(sh, points, 4);
+
+  uint32_t found[4];
+  uint32_t n = spatial_hash_query_radius(sh, (Vector){0.0f, 0.0f}, 1e9f, found, 4);
+  TEST_ASSERT_EQ(n, 2, "Huge radius should find the near points only");
+  n = spatial_hash_query_radius(sh, (Vector){0.0f, 0.0f}, 1e31f, found, 4);
+  TEST_ASSERT_EQ(n, 4, "Radius beyond all points should find every point");
+  Rect all = {{-1e31f, -1e31f}, 2e31f, 2e31f};
+  TEST_ASSERT_EQ(spatial_hash_query_rect(sh, all, found, 4), 4, "Rect over everything finds every point");
+
+  // Far point lies in a clamped edge cell and is still found by a small query around it
+  Rect far = {{-3e9f - 1.0f, 4.0f}, 2.0f, 2.0f};
+  n = spatial_hash_query_rect(sh, far, found, 4);
+  TEST_ASSERT(n == 1 && found[0] == 1, "Far point should be found by a small query");
+  n = spatial_hash_query_radius(sh, (Vector){10.0f, 10.0f}, 1.0f, found, 4);
+  TEST_ASSERT(n == 1 && found[0] == 0, "Small query should still use cells");
+
+  spatial_hash_free(sh);
+}
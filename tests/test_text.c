@@ -0,0 +1,97 @@
+#include "test_framework.h"
+#include <SDL2/SDL_ttf.h>
+#include <engine/text.h>
+
+static TTF_Font *open_test_font(void) {
+  if (TTF_Init() != 0) return NULL;
+  return TTF_OpenFont("demo/fonts/DejaVuSans.ttf", 16);
+}
+
+static void close_test_font(TTF_Font *font) {
+  if (font) TTF_CloseFont(font);
+  TTF_Quit();
+}
+
+// Width of a string is the sum of advances; unknown characters are drawn as '?'
+REGISTER_TEST(text_measure_uses_glyph_advances) {
+  TTF_Font *font = open_test_font();
+  TEST_ASSERT_NOT_NULL(font, "Failed to open font");
+  GlyphAtlas *atlas = glyph_atlas_create(font);
+  TEST_ASSERT_NOT_NULL(atlas, "Failed to create atlas");
+
+  TEST_ASSERT(glyph_atlas_line_height(atlas) > 0, "Line height should be positive");
+  TEST_ASSERT_EQ(text_measure(atlas, ""), 0, "Empty text has no width");
+  TEST_ASSERT(text_measure(atlas, "Coords") > text_measure(atlas, "Coo"), "Longer text should be wider");
+  TEST_ASSERT_EQ(text_measure(atlas, "a\xc3\xa9"), text_measure(atlas, "a?"), "Non-ASCII should be '?'");
+
+  glyph_atlas_free(atlas);
+  close_test_font(font);
+}
+
+// Text partially outside of destination must be clipped: result equals the same region of
+// a big buffer where nothing is clipped
+REGISTER_TEST(text_draw_clips_to_buffer) {
+  TTF_Font *font = open_test_font();
+  TEST_ASSERT_NOT_NULL(font, "Failed to open font");
+  GlyphAtlas *atlas = glyph_atlas_create(font);
+  TEST_ASSERT_NOT_NULL(atlas, "Failed to create atlas");
+
+  enum { SMALL = 10, BIG = 100, OFFSET = 40 };
+  static uint32_t small[SMALL * SMALL], big[BIG * BIG];
+  int xs[] = {-20, -3, 5}, ys[] = {-7, 2, 8};
+  bool drawn = false;
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < SMALL * SMALL; k++) small[k] = 0xFF000000;
+      for (int k = 0; k < BIG * BIG; k++) big[k] = 0xFF000000;
+      text_draw(atlas, small, SMALL, SMALL, xs[i], ys[j], "WWW@@", 0xFFFFFFFF);
+      text_draw(atlas, big, BIG, BIG, xs[i] + OFFSET, ys[j] + OFFSET, "WWW@@", 0xFFFFFFFF);
+
+      for (int y = 0; y < SMALL; y++) {
+        for (int x = 0; x < SMALL; x++) {
+          uint32_t expected = big[(y + OFFSET) * BIG + x + OFFSET];
+          TEST_ASSERT_EQ(small[y * SMALL + x], expected, "Clipped text differs from unclipped");
+          if (expected != 0xFF000000) drawn = true;
+        }
+      }
+    }
+  }
+  TEST_ASSERT(drawn, "Text should be visible in some positions");
+
+  glyph_atlas_free(atlas);
+  close_test_font(font);
+}
+
+// Label keeps its buffer when text gets shorter and grows it only when needed
+REGISTER_TEST(text_label_reuses_buffer) {
+  TTF_Font *font = open_test_font();
+  TEST_ASSERT_NOT_NULL(font, "Failed to open font");
+  GlyphAtlas *atlas = glyph_atlas_create(font);
+  TEST_ASSERT_NOT_NULL(atlas, "Failed to create atlas");
+
+  TextLabel label = {0};
+  TEST_ASSERT(text_label_set(&label, atlas, "FPS: 1000", 0x80FF0000), "Failed to set text");
+  TEST_ASSERT_EQ(label.sprite.width, text_measure(atlas, "FPS: 1000"), "Sprite width should match text");
+  TEST_ASSERT_EQ(label.sprite.height, glyph_atlas_line_height(atlas), "Sprite height should be line height");
+  uint32_t *pixels = label.sprite.pixels;
+
+  TEST_ASSERT(text_label_set(&label, atlas, "FPS: 60", 0x80FF0000), "Failed to set text");
+  TEST_ASSERT(label.sprite.pixels == pixels, "Shorter text should reuse buffer");
+
+  bool has_text = false;
+  for (uint32_t i = 0; i < label.sprite.width * label.sprite.height; i++) {
+    uint32_t p = label.sprite.pixels[i];
+    TEST_ASSERT((p >> 24) <= 0x80, "Alpha should not exceed color alpha");
+    if (p >> 24) {
+      has_text = true;
+      TEST_ASSERT_EQ(p & 0x00FFFFFF, 0x00FF0000, "Text pixels should have text color");
+    }
+  }
+  TEST_ASSERT(has_text, "Label should contain text");
+
+  text_label_free(&label);
+  TEST_ASSERT_NULL(label.sprite.pixels, "Label should be cleared");
+  glyph_atlas_free(atlas);
+  close_test_font(font);
+}
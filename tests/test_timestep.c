@@ -0,0 +1,72 @@
+#include "test_framework.h"
+#include <engine/timestep.h>
+
+// Frames exactly one step long run exactly one tick each
+REGISTER_TEST(tick_clock_one_tick_per_step) {
+  TickClock clock;
+  tick_clock_init(&clock, 50.0f);
+  TEST_ASSERT_FLOAT_EQ(clock.step, 0.02f, 1e-6f, "Step should be 1/rate");
+
+  uint32_t total = 0;
+  for (int i = 0; i < 100; i++) total += tick_clock_advance(&clock, 0.02f + 1e-5f);
+  TEST_ASSERT_EQ(total, 100, "Every frame should run one tick");
+  TEST_ASSERT_EQ(clock.stats.late_ticks, 0, "No tick should be late");
+  TEST_ASSERT_EQ(clock.stats.overrun_frames, 0, "No frame should overrun");
+}
+
+// Short frames accumulate; alpha reports fraction of a step
+REGISTER_TEST(tick_clock_accumulates_short_frames) {
+  TickClock clock;
+  tick_clock_init(&clock, 10.0f);
+
+  TEST_ASSERT_EQ(tick_clock_advance(&clock, 0.025f), 0, "Quarter step shouldn't run a tick");
+  TEST_ASSERT_FLOAT_EQ(tick_clock_alpha(&clock), 0.25f, 1e-4f, "Alpha should be a quarter");
+  TEST_ASSERT_EQ(tick_clock_advance(&clock, 0.1f), 1, "Accumulated time should run one tick");
+  TEST_ASSERT_FLOAT_EQ(tick_clock_alpha(&clock), 0.25f, 1e-4f, "Remainder should be kept");
+}
+
+// Long frame: catch-up ticks are late; the rest is handled by policy
+REGISTER_TEST(tick_clock_overrun_policies) {
+  TickClock clock;
+
+  tick_clock_init(&clock, 8.0f);
+  clock.max_ticks = 3;
+  clock.policy = TICK_OVERRUN_DROP;
+  TEST_ASSERT_EQ(tick_clock_advance(&clock, 1.3125f), 3, "Drop: budget should be run");
+  TEST_ASSERT_EQ(clock.stats.late_ticks, 2, "Drop: ticks after the first are late");
+  TEST_ASSERT_EQ(clock.stats.skipped_ticks, 7, "Drop: ticks over budget are skipped");
+  TEST_ASSERT_EQ(clock.stats.overrun_frames, 1, "Drop: overrun should be counted");
+  TEST_ASSERT_FLOAT_EQ(tick_clock_alpha(&clock), 0.5f, 1e-3f, "Drop: fraction of a step is kept");
+
+  tick_clock_init(&clock, 8.0f);
+  clock.max_ticks = 3;
+  clock.policy = TICK_OVERRUN_SLOW_MOTION;
+  TEST_ASSERT_EQ(tick_clock_advance(&clock, 1.3125f), 3, "Slow motion: budget should be run");
+  TEST_ASSERT_EQ(clock.stats.skipped_ticks, 0, "Slow motion: nothing is skipped");
+  TEST_ASSERT_EQ(clock.stats.overrun_frames, 1, "Slow motion: overrun should be counted");
+  TEST_ASSERT_EQ(tick_clock_advance(&clock, 0.0f), 0, "Slow motion: no backlog is left");
+
+  tick_clock_init(&clock, 8.0f);
+  clock.max_ticks = 3;
+  clock.policy = TICK_OVERRUN_REPORT;
+  TEST_ASSERT_EQ(tick_clock_advance(&clock, 1.3125f), 3, "Report: budget should be run");
+  TEST_ASSERT_EQ(clock.stats.skipped_ticks, 0, "Report: nothing is skipped");
+  TEST_ASSERT_EQ(clock.stats.overrun_frames, 1, "Report: overrun should be counted");
+  TEST_ASSERT_EQ(tick_clock_advance(&clock, 0.0f), 3, "Report: backlog runs in next frame");
+  TEST_ASSERT_EQ(tick_clock_advance(&clock, 0.0f), 3, "Report: backlog runs at most budget");
+  TEST_ASSERT_EQ(tick_clock_advance(&clock, 0.0f), 1, "Report: rest of backlog runs");
+  TEST_ASSERT_EQ(clock.stats.ticks, 10, "Report: every tick eventually runs");
+}
+
+// Changing rate keeps fraction of a step and rejects invalid rates
+REGISTER_TEST(tick_clock_set_rate) {
+  TickClock clock;
+  tick_clock_init(&clock, 10.0f);
+  tick_clock_advance(&clock, 0.05f);
+
+  TEST_ASSERT(tick_clock_set_rate(&clock, 20.0f), "Positive rate should be accepted");
+  TEST_ASSERT_FLOAT_EQ(tick_clock_alpha(&clock), 0.5f, 1e-4f, "Alpha should survive rate change");
+  TEST_ASSERT(!tick_clock_set_rate(&clock, 0.0f), "Zero rate should be rejected");
+  TEST_ASSERT(!tick_clock_set_rate(&clock, -5.0f), "Negative rate should be rejected");
+  TEST_ASSERT_FLOAT_EQ(clock.step, 0.05f, 1e-6f, "Rejected rate shouldn't change step");
+}
@@ -0,0 +1,179 @@
+#include "graphics/camera.h"
+#include "graphics/render.h"
+#include "graphics/ui_priv.h"
+#include "test_framework.h"
+#include <engine/types.h>
+#include <engine/ui.h>
+
+#define SCREEN_W 64
+#define SCREEN_H 48
+
+static Sprite make_sprite(uint32_t w, uint32_t h, uint32_t color) {
+  Sprite sprite = {calloc(w * h, sizeof(uint32_t)), w, h};
+  for (uint32_t i = 0; i < w * h; i++) sprite.pixels[i] = color;
+  return sprite;
+}
+
+static UIElement screen_ui(Sprite *sprite, float x, float y, int z) {
+  UIElement ui = {0};
+  ui.mode = UI_POS_SCREEN;
+  ui.position.screen = (Vector){x, y};
+  ui.sprite = sprite;
+  ui.z_index = z;
+  return ui;
+}
+
+static void clear(uint32_t *fb) {
+  for (int i = 0; i < SCREEN_W * SCREEN_H; i++) fb[i] = 0xFF204060;
+}
+
+// Channels may differ only by rounding
+static bool colors_close(uint32_t a, uint32_t b) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    int ca = (a >> shift) & 0xFF, cb = (b >> shift) & 0xFF;
+    if (ca - cb > 2 || cb - ca > 2) return false;
+  }
+  return true;
+}
+
+// Cached overlay must look the same as blending elements one by one
+REGISTER_TEST(ui_layer_matches_direct_rendering) {
+  Camera *camera = camera_create(SCREEN_W, SCREEN_H);
+  Sprite sprites[3] = {
+      make_sprite(20, 10, 0x80FF0000), make_sprite(10, 20, 0xC000FF00), make_sprite(30, 30, 0x400000FF)};
+  // Added not in z order, last one is partially off-screen
+  UIElement uis[3] = {
+      screen_ui(&sprites[0], 5, 5, 2), screen_ui(&sprites[1], 10, 0, 1), screen_ui(&sprites[2], 50, 30, 3)};
+
+  static uint32_t direct[SCREEN_W * SCREEN_H], cached[SCREEN_W * SCREEN_H];
+  UIElement *ptrs[3] = {&uis[0], &uis[1], &uis[2]};
+  RenderBatch batch = {0};
+  batch.uis = ptrs;
+  batch.ui_count = 3;
+  clear(direct);
+  render_batch(direct, &batch, camera, 1.0f);
+
+  UILayer *layer = ui_layer_create();
+  TEST_ASSERT_NOT_NULL(layer, "Failed to create layer");
+  for (int i = 0; i < 3; i++) TEST_ASSERT(ui_layer_add(layer, &uis[i]), "Failed to add element");
+  batch = (RenderBatch){0};
+  batch.ui_layer = layer;
+  for (int frame = 0; frame < 2; frame++) {
+    clear(cached);
+    render_batch(cached, &batch, camera, 1.0f);
+    for (int i = 0; i < SCREEN_W * SCREEN_H; i++) {
+      TEST_ASSERT(colors_close(direct[i], cached[i]), "Layer differs from direct rendering");
+    }
+  }
+  TEST_ASSERT_EQ(layer->segment_count, 2, "Overlapping elements should share an overlay, the far one not");
+  TEST_ASSERT_EQ(layer->entries[0].segment, layer->entries[1].segment, "Overlapping elements share overlay");
+
+  ui_layer_free(layer);
+  for (int i = 0; i < 3; i++) free_sprite(&sprites[i]);
+  camera_free(camera);
+}
+
+// Far-apart HUD elements get separate overlays, so a change of one doesn't recomposite the screen
+REGISTER_TEST(ui_layer_splits_far_elements) {
+  Camera *camera = camera_create(SCREEN_W, SCREEN_H);
+  Sprite label = make_sprite(8, 4, 0xFFFFFFFF), map = make_sprite(12, 8, 0xFF00FF00);
+  UIElement fps = screen_ui(&label, 0, 0, 0);
+  UIElement coords = screen_ui(&label, 0, 5, 0);
+  UIElement minimap = screen_ui(&map, SCREEN_W - 12, 0, 0);
+
+  UILayer *layer = ui_layer_create();
+  ui_layer_add(layer, &fps);
+  ui_layer_add(layer, &coords);
+  ui_layer_add(layer, &minimap);
+  static uint32_t fb[SCREEN_W * SCREEN_H];
+  clear(fb);
+  render_ui_layer(fb, layer, camera, 1.0f);
+  TEST_ASSERT_EQ(layer->segment_count, 2, "Minimap should not share overlay with the labels");
+  UISegment *labels = &layer->segments[0];
+  TEST_ASSERT_EQ(labels->count, 2, "Adjacent labels should share an overlay");
+  TEST_ASSERT(labels->width == 8 && labels->height == 9, "Overlay should cover only the labels");
+  TEST_ASSERT_EQ(fb[SCREEN_W - 1], 0xFF00FF00, "Minimap should be drawn");
+
+  ui_layer_free(layer);
+  free_sprite(&label);
+  free_sprite(&map);
+  camera_free(camera);
+}
+
+// Overlay is recomposited only after invalidation
+REGISTER_TEST(ui_layer_recomposites_on_invalidate) {
+  Camera *camera = camera_create(SCREEN_W, SCREEN_H);
+  Sprite sprite = make_sprite(4, 4, 0xFFFF0000);
+  UIElement ui = screen_ui(&sprite, 8, 8, 0);
+  UILayer *layer = ui_layer_create();
+  ui_layer_add(layer, &ui);
+
+  static uint32_t fb[SCREEN_W * SCREEN_H];
+  clear(fb);
+  render_ui_layer(fb, layer, camera, 1.0f);
+  TEST_ASSERT_EQ(fb[9 * SCREEN_W + 9], 0xFFFF0000, "Element should be drawn");
+
+  for (int i = 0; i < 16; i++) sprite.pixels[i] = 0xFF00FF00;
+  clear(fb);
+  render_ui_layer(fb, layer, camera, 1.0f);
+  TEST_ASSERT_EQ(fb[9 * SCREEN_W + 9], 0xFFFF0000, "Overlay should stay cached until invalidated");
+
+  ui_layer_invalidate(layer, &ui);
+  clear(fb);
+  render_ui_layer(fb, layer, camera, 1.0f);
+  TEST_ASSERT_EQ(fb[9 * SCREEN_W + 9], 0xFF00FF00, "Overlay should be recomposited");
+
+  ui.position.screen = (Vector){20, 20};
+  ui_layer_invalidate(layer, &ui);
+  clear(fb);
+  render_ui_layer(fb, layer, camera, 1.0f);
+  TEST_ASSERT_EQ(fb[9 * SCREEN_W + 9], 0xFF204060, "Old place should be cleared");
+  TEST_ASSERT_EQ(fb[21 * SCREEN_W + 21], 0xFF00FF00, "Element should be drawn at new place");
+
+  ui_layer_remove(layer, &ui);
+  clear(fb);
+  render_ui_layer(fb, layer, camera, 1.0f);
+  TEST_ASSERT_EQ(fb[21 * SCREEN_W + 21], 0xFF204060, "Removed element should not be drawn");
+
+  ui_layer_free(layer);
+  free_sprite(&sprite);
+  camera_free(camera);
+}
+
+// Elements stay sorted by z-index; attached elements split overlays to keep z order
+REGISTER_TEST(ui_layer_keeps_z_order) {
+  Camera *camera = camera_create(SCREEN_W, SCREEN_H);
+  Sprite red = make_sprite(4, 4, 0xFFFF0000), green = make_sprite(4, 4, 0xFF00FF00);
+  GameObject obj = {0};
+  UIElement bottom = screen_ui(&red, 0, 0, 0);
+  UIElement top = screen_ui(&green, 0, 0, 5);
+  UIElement attached = {0};
+  attached.mode = UI_POS_ATTACHED;
+  attached.position.attached.object = &obj;
+  attached.sprite = &red;
+  attached.z_index = 3;
+
+  UILayer *layer = ui_layer_create();
+  ui_layer_add(layer, &top);
+  ui_layer_add(layer, &attached);
+  ui_layer_add(layer, &bottom);
+
+  static uint32_t fb[SCREEN_W * SCREEN_H];
+  clear(fb);
+  render_ui_layer(fb, layer, camera, 1.0f);
+  TEST_ASSERT(layer->entries[0].ui == &bottom && layer->entries[2].ui == &top, "Entries should be sorted");
+  TEST_ASSERT_EQ(layer->segment_count, 2, "Attached element should split overlays");
+  TEST_ASSERT_EQ(fb[0], 0xFF00FF00, "Highest z-index should be on top");
+
+  top.z_index = -1;
+  ui_layer_invalidate(layer, &top);
+  clear(fb);
+  render_ui_layer(fb, layer, camera, 1.0f);
+  TEST_ASSERT(layer->entries[0].ui == &top, "Element should move after z-index change");
+  TEST_ASSERT_EQ(fb[0], 0xFFFF0000, "Order should follow new z-index");
+
+  ui_layer_free(layer);
+  free_sprite(&red);
+  free_sprite(&green);
+  camera_free(camera);
+}